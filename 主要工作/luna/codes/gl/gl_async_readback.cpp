@@ -0,0 +1,281 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: asynchronous readback by pooled PBO & fence
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_texture_streamer.h"
+
+#include "gl_async_readback.h"
+
+namespace luna {
+
+namespace {
+
+//NOTE: pack PBOs are recycled instead of being created per readback, must be used on GL thread
+constexpr size_t MAX_POOLED_BUFFER_NUM = 8;
+
+std::vector<std::unique_ptr<GLPixelBuffer>>& getPackBufferPool()
+{
+    static std::vector<std::unique_ptr<GLPixelBuffer>> pool;
+    return pool;
+}
+
+std::unique_ptr<GLPixelBuffer> acquirePackBuffer(int size)
+{
+    auto& pool = getPackBufferPool();
+
+    //prefer the smallest buffer which is large enough
+    int best = -1;
+    for (int i = 0; i < static_cast<int>(pool.size()); ++i)
+    {
+        if (pool[i]->size() >= size && (best < 0 || pool[i]->size() < pool[best]->size()))
+            best = i;
+    }
+
+    if (best >= 0)
+    {
+        std::unique_ptr<GLPixelBuffer> pbo = std::move(pool[best]);
+        pool.erase(pool.begin() + best);
+        return pbo;
+    }
+
+    auto pbo = std::make_unique<GLPixelBuffer>(GL_PIXEL_PACK_BUFFER);
+    pbo->update(nullptr, size, GL_STREAM_READ);
+    pbo->unbind();
+
+    return pbo;
+}
+
+void recyclePackBuffer(std::unique_ptr<GLPixelBuffer> pbo)
+{
+    auto& pool = getPackBufferPool();
+
+    if (pool.size() >= MAX_POOLED_BUFFER_NUM)
+        pool.erase(pool.begin()); //drop the oldest one
+
+    pool.push_back(std::move(pbo));
+}
+
+int getCVDepth(GLenum type)
+{
+    if (type == GL_UNSIGNED_BYTE)
+        return CV_8U;
+    if (type == GL_UNSIGNED_SHORT)
+        return CV_16U;
+    if (type == GL_UNSIGNED_INT || type == GL_INT)
+        return CV_32S;
+    if (type == GL_HALF_FLOAT)
+        return CV_16F; //e.g. GL_RGBA16F targets, copyTo with HALF_TO_FLOAT for CV_32F
+    if (type == GL_FLOAT)
+        return CV_32F;
+
+    throw std::invalid_argument("error: unsupported data type");
+}
+
+}//end of anonymous namespace
+
+GLAsyncReadback::GLAsyncReadback(int width, int height, GLenum format, GLenum type)
+{
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    m_width = width;
+    m_height = height;
+    m_format = format;
+    m_type = type;
+
+    //rows are aligned to GL_PACK_ALIGNMENT (4), i.e. the fast path of most drivers
+    const int channel_num = (format == GL_DEPTH_COMPONENT) ? 1 : GLTexture::getChannelNum(format);
+    m_row_bytes = (m_width * channel_num * GLTextureStreamer::getTypeSize(type) + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+
+    m_pbo = acquirePackBuffer(m_row_bytes * m_height);
+}
+
+GLAsyncReadback& GLAsyncReadback::operator = (GLAsyncReadback&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->destroy();
+
+        m_pbo = std::move(rhs.m_pbo);
+        m_fence = std::move(rhs.m_fence);
+
+        m_width = rhs.m_width;
+        m_height = rhs.m_height;
+        m_format = rhs.m_format;
+        m_type = rhs.m_type;
+        m_row_bytes = rhs.m_row_bytes;
+        m_is_mapped = rhs.m_is_mapped;
+
+        rhs.m_is_mapped = false;
+    }
+    return *this;
+}
+
+GLAsyncReadback::~GLAsyncReadback()
+{
+    this->destroy();
+}
+
+void GLAsyncReadback::destroy()
+{
+    if (m_pbo)
+    {
+        this->unmap();
+
+        m_fence.destroy();
+
+        recyclePackBuffer(std::move(m_pbo));
+    }
+
+    m_width = 0;
+    m_height = 0;
+    m_row_bytes = 0;
+}
+
+bool GLAsyncReadback::isValid() const
+{
+    return m_pbo != nullptr;
+}
+
+bool GLAsyncReadback::isReady() const
+{
+    return m_pbo != nullptr && m_fence.isSignaled();
+}
+
+bool GLAsyncReadback::wait(uint64_t timeout_ns) const
+{
+    return m_pbo != nullptr && m_fence.wait(timeout_ns);
+}
+
+cv::Mat GLAsyncReadback::map()
+{
+    if (!m_pbo)
+    {
+        LOGE("error: invalid readback handle");
+        throw std::runtime_error("error: invalid readback handle");
+    }
+
+    if (m_is_mapped)
+    {
+        LOGE("error: readback is already mapped");
+        throw std::runtime_error("error: readback is already mapped");
+    }
+
+    //blocks only if GPU has not finished yet
+    m_fence.wait();
+
+    void* ptr = m_pbo->map(0, m_row_bytes * m_height, GL_MAP_READ_BIT);
+    m_pbo->unbind();
+
+    if (ptr == nullptr)
+        return {};
+
+    m_is_mapped = true;
+
+    return cv::Mat(m_height, m_width, this->getCVType(), ptr, m_row_bytes);
+}
+
+void GLAsyncReadback::unmap()
+{
+    if (m_pbo && m_is_mapped)
+    {
+        m_pbo->unmap();
+        m_pbo->unbind();
+        m_is_mapped = false;
+    }
+}
+
+bool GLAsyncReadback::copyTo(cv::Mat& dst, bool vertical_flip)
+{
+    return this->copyTo(dst, PixelConversion::COPY, vertical_flip);
+}
+
+bool GLAsyncReadback::copyTo(cv::Mat& dst, PixelConversion conversion, bool vertical_flip)
+{
+    cv::Mat src = this->map();
+    if (src.empty())
+    {
+        LOGE("error: can not map readback");
+        return false;
+    }
+
+    const int channel_num = src.channels();
+
+    int dst_type = src.type();
+    if (conversion == PixelConversion::RGBA_TO_RGB || conversion == PixelConversion::RGBA_TO_BGR)
+        dst_type = CV_8UC3;
+    else if (conversion == PixelConversion::U8_TO_FLOAT || conversion == PixelConversion::HALF_TO_FLOAT)
+        dst_type = CV_32FC(channel_num);
+    else if (conversion == PixelConversion::FLOAT_TO_HALF)
+        dst_type = CV_16FC(channel_num);
+
+    dst.create(m_height, m_width, dst_type);
+
+    //COPY works on bytes
+    const int element_num = (conversion == PixelConversion::COPY) ? static_cast<int>(src.elemSize()) : channel_num;
+
+    convertImage(src.data, src.step[0], dst.data, dst.step[0], m_width, m_height, element_num, conversion, vertical_flip);
+
+    this->unmap();
+
+    return true;
+}
+
+int GLAsyncReadback::getWidth() const
+{
+    return m_width;
+}
+
+int GLAsyncReadback::getHeight() const
+{
+    return m_height;
+}
+
+GLenum GLAsyncReadback::getFormat() const
+{
+    return m_format;
+}
+
+GLenum GLAsyncReadback::getType() const
+{
+    return m_type;
+}
+
+int GLAsyncReadback::getRowBytes() const
+{
+    return m_row_bytes;
+}
+
+int GLAsyncReadback::getCVType() const
+{
+    const int channel_num = (m_format == GL_DEPTH_COMPONENT) ? 1 : GLTexture::getChannelNum(m_format);
+    return CV_MAKETYPE(getCVDepth(m_type), channel_num);
+}
+
+GLPixelBuffer& GLAsyncReadback::getPixelBuffer()
+{
+    return *m_pbo;
+}
+
+GLFence& GLAsyncReadback::getFence()
+{
+    return m_fence;
+}
+
+void GLAsyncReadback::clearBufferPool()
+{
+    getPackBufferPool().clear();
+}
+
+}//end of namespace luna
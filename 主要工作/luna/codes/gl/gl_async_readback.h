@@ -0,0 +1,122 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: asynchronous readback by pooled PBO & fence
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+#include "gl_pixel_buffer.h"
+#include "gl_fence.h"
+#include "gl_pixel_convert.h"
+
+namespace luna {
+
+//NOTE: typical usage for output-to-video:
+//
+//    //frame N
+//    pending.push_back(fbo.readAsync());
+//
+//    //frame N + k, no stall if GPU has finished
+//    if (pending.front().isReady())
+//    {
+//        GLMappedImage view(std::move(pending.front())); //no copy, rows are bottom-up (opengl convention)
+//        encoder.encode(view.mat());
+//        pending.pop_front();                              //view unmaps & recycles PBO on destruction
+//    }
+//
+//    All methods must be called on the thread owning the GL context.
+
+class GLAsyncReadback
+{
+public:
+
+    GLAsyncReadback() = default;
+
+    GLAsyncReadback(int width, int height, GLenum format, GLenum type);
+
+    ~GLAsyncReadback();
+
+    void destroy();
+
+    //disable copy
+    GLAsyncReadback(const GLAsyncReadback& rhs) = delete;
+    GLAsyncReadback& operator = (const GLAsyncReadback& rhs) = delete;
+
+    //enable move
+    GLAsyncReadback(GLAsyncReadback&& rhs) noexcept = default;
+    GLAsyncReadback& operator = (GLAsyncReadback&& rhs) noexcept;
+
+    //-----------
+
+    bool isValid() const;
+
+    //non-blocking, true if GPU has finished writing the PBO
+    bool isReady() const;
+
+    //block until ready or timeout
+    bool wait(uint64_t timeout_ns = UINT64_MAX) const;
+
+    //map PBO and return a cv::Mat header over the mapped memory (blocks if not ready),
+    //view is valid until unmap() or destruction, prefer GLMappedImage which unmaps automatically
+    cv::Mat map();
+
+    void unmap();
+
+    //map, copy into dst (reallocated if necessary) and unmap, blocks if not ready
+    //vertical_flip reverses rows during the copy, i.e. no extra cv::flip pass
+    bool copyTo(cv::Mat& dst, bool vertical_flip = false);
+
+    //conversion is fused into the same copy, e.g. RGBA_TO_RGB, dst type follows the conversion,
+    //GL_HALF_FLOAT readbacks map to CV_16F, HALF_TO_FLOAT gives CV_32F
+    bool copyTo(cv::Mat& dst, PixelConversion conversion, bool vertical_flip = false);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    GLenum getFormat() const;
+
+    GLenum getType() const;
+
+    int getRowBytes() const;
+
+    int getCVType() const;
+
+    //-----------
+    //used by GLFrameBuffer & GLTexture to issue the readback
+
+    GLPixelBuffer& getPixelBuffer();
+
+    GLFence& getFence();
+
+    //release all pooled PBOs, e.g. before destroying the GL context
+    static void clearBufferPool();
+
+    static constexpr int PACK_ALIGNMENT = 4;
+
+private:
+    std::unique_ptr<GLPixelBuffer> m_pbo;
+
+    GLFence m_fence;
+
+    int m_width = 0;
+    int m_height = 0;
+
+    GLenum m_format = GL_RGBA;
+    GLenum m_type = GL_UNSIGNED_BYTE;
+
+    int m_row_bytes = 0;
+
+    bool m_is_mapped = false;
+};
+
+}//end of namespace luna
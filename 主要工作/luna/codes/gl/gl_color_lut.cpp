@@ -0,0 +1,375 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: 3d color lookup table (.cube) on GPU, i.e. color grading in a single pass
+ * @version    : 1.0
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_render_pass.h"
+
+#include "gl_color_lut.h"
+
+namespace luna {
+
+static const char* COLOR_LUT_FRAGMENT_SHADER = R"(
+precision highp float;
+
+in vec2 v_tex_coord;
+
+uniform sampler2D u_tex_src;
+uniform highp sampler3D u_tex_lut;
+
+uniform vec3 u_domain_min;
+uniform vec3 u_domain_max;
+uniform float u_lut_size;
+uniform float u_intensity;
+
+out vec4 frag_color;
+
+void main()
+{
+    vec4 color = texture(u_tex_src, v_tex_coord);
+
+    vec3 x = clamp((color.rgb - u_domain_min) / (u_domain_max - u_domain_min), 0.0, 1.0);
+
+    //lattice point i is the center of texel i, i.e. [0, 1] maps to [0.5 / size, 1 - 0.5 / size]
+    vec3 uvw = x * ((u_lut_size - 1.0) / u_lut_size) + 0.5 / u_lut_size;
+
+    vec3 graded = texture(u_tex_lut, uvw).rgb;
+
+    frag_color = vec4(mix(color.rgb, graded, u_intensity), color.a);
+}
+)";
+
+//binary cache: magic, version, size, domain_min, domain_max, title length, title, size^3 * 3 floats
+static const char CUBE_CACHE_MAGIC[4] = {'L', 'U', 'T', '3'};
+static const uint32_t CUBE_CACHE_VERSION = 1;
+
+GLColorLUT::GLColorLUT(const std::string& cube_file, const std::string& cache_file)
+{
+    bool succ = this->load(cube_file, cache_file);
+    if (!succ)
+    {
+        LOGE("error: can not init GLColorLUT");
+        throw std::invalid_argument("error: can not init GLColorLUT");
+    }
+}
+
+bool GLColorLUT::load(const std::string& cube_file, const std::string& cache_file)
+{
+    const std::string cache_path = cache_file.empty() ? cube_file + ".bin" : cache_file;
+
+    //cache is valid only if it was written after the last change of the .cube file
+    std::error_code error;
+    const bool cache_fresh = std::filesystem::exists(cache_path, error) &&
+                             std::filesystem::last_write_time(cache_path, error) >= std::filesystem::last_write_time(cube_file, error) &&
+                             !error;
+
+    CubeLUTData lut;
+
+    if (!cache_fresh || !readCache(cache_path, lut))
+    {
+        parseCubeFile(cube_file, lut);
+
+        //NOTE: failing to write the cache (e.g. read-only directory) only costs the next load
+        writeCache(cache_path, lut);
+    }
+
+    return this->init(lut);
+}
+
+bool GLColorLUT::init(const CubeLUTData& lut)
+{
+    const size_t expected_num = static_cast<size_t>(lut.size) * lut.size * lut.size * 3;
+
+    if (lut.size < 2 || lut.data.size() != expected_num)
+    {
+        LOGE("error: invalid lut, size: %d, data num: %d", lut.size, static_cast<int>(lut.data.size()));
+        throw std::invalid_argument("error: invalid lut");
+        return false;
+    }
+
+    if (lut.domain_max.x <= lut.domain_min.x || lut.domain_max.y <= lut.domain_min.y || lut.domain_max.z <= lut.domain_min.z)
+    {
+        LOGE("error: invalid lut domain");
+        throw std::invalid_argument("error: invalid lut domain");
+        return false;
+    }
+
+    //storage is immutable, reallocate only if the lattice size changes
+    if (!m_lut_tex.isValid() || m_lut_tex.getWidth() != lut.size)
+        m_lut_tex.init(lut.size, lut.size, lut.size, GL_RGB16F);
+
+    m_lut_tex.update(lut.data.data(), GL_RGB);
+
+    m_domain_min = lut.domain_min;
+    m_domain_max = lut.domain_max;
+
+    return true;
+}
+
+void GLColorLUT::destroy()
+{
+    m_lut_tex.destroy();
+    m_shader.destroy();
+
+    m_domain_min = glm::vec3(0.0f);
+    m_domain_max = glm::vec3(1.0f);
+}
+
+bool GLColorLUT::apply(const GLTexture& src, GLFrameBuffer& dst, float intensity)
+{
+    if (!m_lut_tex.isValid())
+    {
+        LOGE("error: lut is not loaded");
+        throw std::runtime_error("error: lut is not loaded");
+        return false;
+    }
+
+    if (!src.isValid())
+    {
+        LOGE("error: invalid src texture");
+        throw std::invalid_argument("error: invalid src texture");
+        return false;
+    }
+
+    if (!m_shader.isValid())
+        m_shader.createFromString(GLFullScreenPass::getVertexShaderSource(), COLOR_LUT_FRAGMENT_SHADER);
+
+    //every texel is overwritten
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::DONT_CARE;
+
+    dst.beginRenderPass(render_pass);
+
+    m_shader.use();
+    m_shader.setTexture("u_tex_src", src);
+    GLFullScreenPass::setTexCoordFlip(m_shader, src.isVerticalFlipped());
+    m_shader.setTexture("u_tex_lut", m_lut_tex);
+    m_shader.setVec3("u_domain_min", m_domain_min);
+    m_shader.setVec3("u_domain_max", m_domain_max);
+    m_shader.setFloat("u_lut_size", static_cast<float>(m_lut_tex.getWidth()));
+    m_shader.setFloat("u_intensity", intensity);
+
+    m_fullscreen_pass.draw();
+
+    m_shader.unUse();
+
+    dst.endRenderPass();
+
+    return true;
+}
+
+const GLTexture3D& GLColorLUT::getTexture() const
+{
+    return m_lut_tex;
+}
+
+int GLColorLUT::getSize() const
+{
+    return m_lut_tex.getWidth();
+}
+
+bool GLColorLUT::isValid() const
+{
+    return m_lut_tex.isValid();
+}
+
+bool GLColorLUT::parseCubeFile(const std::string& cube_file, CubeLUTData& lut)
+{
+    std::ifstream input_file(cube_file);
+    if (!input_file.is_open())
+    {
+        LOGE("error: can not open cube file: %s", cube_file.c_str());
+        throw std::invalid_argument("error: can not open cube file");
+        return false;
+    }
+
+    lut = CubeLUTData();
+
+    size_t expected_num = 0;
+
+    std::string line;
+    int line_no = 0;
+
+    while (std::getline(input_file, line))
+    {
+        ++line_no;
+
+        const char* ptr = line.c_str();
+        while (*ptr == ' ' || *ptr == '\t')
+            ++ptr;
+
+        if (*ptr == '\0' || *ptr == '#' || *ptr == '\r')
+            continue;
+
+        //lattice point, by far the most common line
+        if ((*ptr >= '0' && *ptr <= '9') || *ptr == '-' || *ptr == '+' || *ptr == '.')
+        {
+            if (expected_num == 0)
+            {
+                LOGE("error: %s:%d: lut data before LUT_3D_SIZE", cube_file.c_str(), line_no);
+                throw std::runtime_error("error: lut data before LUT_3D_SIZE");
+                return false;
+            }
+
+            char* end = nullptr;
+            for (int c = 0; c < 3; ++c)
+            {
+                const float value = std::strtof(ptr, &end);
+                if (end == ptr)
+                {
+                    LOGE("error: %s:%d: expect 3 values", cube_file.c_str(), line_no);
+                    throw std::runtime_error("error: invalid lut data");
+                    return false;
+                }
+
+                lut.data.push_back(value);
+                ptr = end;
+            }
+
+            continue;
+        }
+
+        if (line.compare(ptr - line.c_str(), 11, "LUT_3D_SIZE") == 0)
+        {
+            lut.size = std::atoi(ptr + 11);
+            if (lut.size < 2 || lut.size > 256)
+            {
+                LOGE("error: %s:%d: invalid LUT_3D_SIZE: %d", cube_file.c_str(), line_no, lut.size);
+                throw std::runtime_error("error: invalid LUT_3D_SIZE");
+                return false;
+            }
+
+            expected_num = static_cast<size_t>(lut.size) * lut.size * lut.size * 3;
+            lut.data.reserve(expected_num);
+        }
+        else if (line.compare(ptr - line.c_str(), 11, "LUT_1D_SIZE") == 0)
+        {
+            LOGE("error: %s: 1d lut is not supported", cube_file.c_str());
+            throw std::runtime_error("error: 1d lut is not supported");
+            return false;
+        }
+        else if (line.compare(ptr - line.c_str(), 10, "DOMAIN_MIN") == 0)
+        {
+            char* end = nullptr;
+            ptr += 10;
+            for (int c = 0; c < 3; ++c, ptr = end)
+                lut.domain_min[c] = std::strtof(ptr, &end);
+        }
+        else if (line.compare(ptr - line.c_str(), 10, "DOMAIN_MAX") == 0)
+        {
+            char* end = nullptr;
+            ptr += 10;
+            for (int c = 0; c < 3; ++c, ptr = end)
+                lut.domain_max[c] = std::strtof(ptr, &end);
+        }
+        else if (line.compare(ptr - line.c_str(), 5, "TITLE") == 0)
+        {
+            const size_t first = line.find('"');
+            const size_t last = line.rfind('"');
+            if (first != std::string::npos && last > first)
+                lut.title = line.substr(first + 1, last - first - 1);
+        }
+        //other keywords (e.g. LUT_3D_INPUT_RANGE of some tools) are ignored
+    }
+
+    if (expected_num == 0 || lut.data.size() != expected_num)
+    {
+        LOGE("error: %s: expect %d values, got %d", cube_file.c_str(), static_cast<int>(expected_num), static_cast<int>(lut.data.size()));
+        throw std::runtime_error("error: lut data num not match LUT_3D_SIZE");
+        return false;
+    }
+
+    return true;
+}
+
+bool GLColorLUT::readCache(const std::string& cache_file, CubeLUTData& lut)
+{
+    std::ifstream input_file(cache_file, std::ios::binary);
+    if (!input_file.is_open())
+        return false;
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    int32_t size = 0;
+    uint32_t title_length = 0;
+
+    input_file.read(magic, sizeof(magic));
+    input_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input_file.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+    if (!input_file || std::memcmp(magic, CUBE_CACHE_MAGIC, sizeof(magic)) != 0 || version != CUBE_CACHE_VERSION || size < 2 || size > 256)
+        return false;
+
+    CubeLUTData cache;
+    cache.size = size;
+
+    float domain[6] = {};
+    input_file.read(reinterpret_cast<char*>(domain), sizeof(domain));
+    input_file.read(reinterpret_cast<char*>(&title_length), sizeof(title_length));
+
+    if (!input_file || title_length > 4096)
+        return false;
+
+    cache.domain_min = glm::vec3(domain[0], domain[1], domain[2]);
+    cache.domain_max = glm::vec3(domain[3], domain[4], domain[5]);
+
+    cache.title.resize(title_length);
+    input_file.read(cache.title.data(), title_length);
+
+    cache.data.resize(static_cast<size_t>(size) * size * size * 3);
+    input_file.read(reinterpret_cast<char*>(cache.data.data()), cache.data.size() * sizeof(float));
+
+    if (!input_file)
+        return false;
+
+    lut = std::move(cache);
+
+    return true;
+}
+
+bool GLColorLUT::writeCache(const std::string& cache_file, const CubeLUTData& lut)
+{
+    std::ofstream output_file(cache_file, std::ios::binary | std::ios::trunc);
+    if (!output_file.is_open())
+    {
+        LOGE("error: can not write lut cache: %s", cache_file.c_str());
+        return false;
+    }
+
+    const int32_t size = lut.size;
+    const uint32_t title_length = static_cast<uint32_t>(lut.title.size());
+
+    const float domain[6] = {lut.domain_min.x, lut.domain_min.y, lut.domain_min.z,
+                             lut.domain_max.x, lut.domain_max.y, lut.domain_max.z};
+
+    output_file.write(CUBE_CACHE_MAGIC, sizeof(CUBE_CACHE_MAGIC));
+    output_file.write(reinterpret_cast<const char*>(&CUBE_CACHE_VERSION), sizeof(CUBE_CACHE_VERSION));
+    output_file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    output_file.write(reinterpret_cast<const char*>(domain), sizeof(domain));
+    output_file.write(reinterpret_cast<const char*>(&title_length), sizeof(title_length));
+    output_file.write(lut.title.data(), title_length);
+    output_file.write(reinterpret_cast<const char*>(lut.data.data()), lut.data.size() * sizeof(float));
+
+    if (!output_file)
+    {
+        LOGE("error: can not write lut cache: %s", cache_file.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}//end of namespace luna
@@ -0,0 +1,97 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: 3d color lookup table (.cube) on GPU, i.e. color grading in a single pass
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "gl_include.h"
+
+#include "gl_texture_3d.h"
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+class GLTexture;
+
+struct CubeLUTData
+{
+    std::string title;
+
+    int size = 0; //lattice points per axis
+
+    glm::vec3 domain_min = glm::vec3(0.0f);
+    glm::vec3 domain_max = glm::vec3(1.0f);
+
+    std::vector<float> data; //size^3 rgb triples, red varies fastest, then green, then blue (.cube order)
+};
+
+//NOTE: parsing a 65^3 .cube text file takes much longer than uploading it, so load() keeps a binary copy
+//      next to it (header + raw floats) and reads that instead while it is newer than the .cube file.
+//      The LUT is a GL_RGB16F 3d texture sampled trilinearly, lookups hit lattice points exactly
+//      at domain_min/domain_max (texel-center remap in the shader).
+
+class GLColorLUT
+{
+public:
+
+    GLColorLUT() = default;
+
+    GLColorLUT(const std::string& cube_file, const std::string& cache_file = {});
+
+    //cache_file empty means cube_file + ".bin", cache is (re)written if missing or stale
+    bool load(const std::string& cube_file, const std::string& cache_file = {});
+
+    bool init(const CubeLUTData& lut);
+
+    ~GLColorLUT() = default;
+
+    void destroy();
+
+    //disable copy
+    GLColorLUT(const GLColorLUT& rhs) = delete;
+    GLColorLUT& operator = (const GLColorLUT& rhs) = delete;
+
+    //enable move
+    GLColorLUT(GLColorLUT&& rhs) noexcept = default;
+    GLColorLUT& operator = (GLColorLUT&& rhs) noexcept = default;
+
+    //-----------
+
+    //dst = mix(src, lut(src), intensity), alpha is kept, src is sampled by v_tex_coord, i.e. may be scaled
+    bool apply(const GLTexture& src, GLFrameBuffer& dst, float intensity = 1.0f);
+
+    const GLTexture3D& getTexture() const;
+
+    int getSize() const;
+
+    bool isValid() const;
+
+    //LUT_3D_SIZE, DOMAIN_MIN/MAX and TITLE are recognized, LUT_1D_SIZE is not supported
+    static bool parseCubeFile(const std::string& cube_file, CubeLUTData& lut);
+
+    //false if the cache is missing or corrupted
+    static bool readCache(const std::string& cache_file, CubeLUTData& lut);
+
+    static bool writeCache(const std::string& cache_file, const CubeLUTData& lut);
+
+private:
+    GLTexture3D m_lut_tex;
+
+    glm::vec3 m_domain_min = glm::vec3(0.0f);
+    glm::vec3 m_domain_max = glm::vec3(1.0f);
+
+    GLShader m_shader;
+    GLFullScreenPass m_fullscreen_pass;
+};
+
+}//end of namespace luna
@@ -0,0 +1,88 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: helper passes shared by the textures & frame buffers of one opengl context
+ * @version    : 1.0
+ */
+
+#include "gl_copy_engine.h"
+#include "gl_mip_generator.h"
+#include "gl_swizzle_pass.h"
+#include "gl_yuv_packer.h"
+
+#include "gl_context_resources.h"
+
+namespace luna {
+
+thread_local GLContextResources* GLContextResources::s_current = nullptr;
+
+GLContextResources::GLContextResources()
+{
+    this->makeCurrent();
+}
+
+GLContextResources::~GLContextResources()
+{
+    this->release();
+
+    if (s_current == this)
+        s_current = nullptr;
+}
+
+void GLContextResources::makeCurrent()
+{
+    s_current = this;
+}
+
+void GLContextResources::release()
+{
+    m_copy_engine.reset();
+    m_mip_generator.reset();
+    m_swizzle_pass.reset();
+    m_yuv_packer.reset();
+}
+
+GLCopyEngine& GLContextResources::getCopyEngine()
+{
+    if (!m_copy_engine)
+        m_copy_engine = std::make_unique<GLCopyEngine>();
+
+    return *m_copy_engine;
+}
+
+GLMipGenerator& GLContextResources::getMipGenerator()
+{
+    if (!m_mip_generator)
+        m_mip_generator = std::make_unique<GLMipGenerator>();
+
+    return *m_mip_generator;
+}
+
+GLSwizzlePass& GLContextResources::getSwizzlePass()
+{
+    if (!m_swizzle_pass)
+        m_swizzle_pass = std::make_unique<GLSwizzlePass>();
+
+    return *m_swizzle_pass;
+}
+
+GLYUVPacker& GLContextResources::getYUVPacker()
+{
+    if (!m_yuv_packer)
+        m_yuv_packer = std::make_unique<GLYUVPacker>();
+
+    return *m_yuv_packer;
+}
+
+GLContextResources& GLContextResources::current()
+{
+    if (s_current != nullptr)
+        return *s_current;
+
+    //created on first use, i.e. callers without setup keep working
+    thread_local GLContextResources default_resources;
+
+    return default_resources;
+}
+
+}//end of namespace luna
@@ -0,0 +1,76 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: helper passes shared by the textures & frame buffers of one opengl context
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "gl_include.h"
+
+namespace luna {
+
+class GLCopyEngine;
+class GLMipGenerator;
+class GLSwizzlePass;
+class GLYUVPacker;
+
+//NOTE: GLTexture (copy, resolve, mip generation, BGR readback) and GLFrameBuffer (BGR readback, readYUV)
+//      use helper passes owning fbos & shaders, i.e. objects of the context they were created in.
+//      To control their lifetime, create one GLContextResources per context on its rendering thread
+//      after the context is made current:
+//
+//    GLContextResources resources;    //registered as current of this thread
+//    ...                              //render, read back
+//    resources.release();             //or let it go out of scope, the context must still be current
+//
+//    Helpers are created lazily on first use, release() deletes them while the context is current,
+//    a later use creates them again. Call makeCurrent() after switching to another context on the same thread.
+//    Without any instance, current() falls back to a default instance of the thread, i.e. no setup is required,
+//    its helpers belong to the first context used on the thread and are deleted at thread exit,
+//    call GLContextResources::current().release() before that context is destroyed.
+
+class GLContextResources
+{
+public:
+
+    //registered as current of the calling thread
+    GLContextResources();
+
+    //release() & unregister, i.e. must be destroyed on its thread with its context current
+    ~GLContextResources();
+
+    //disable copy & move, current instance is registered by address
+    GLContextResources(const GLContextResources& rhs) = delete;
+    GLContextResources& operator = (const GLContextResources& rhs) = delete;
+    GLContextResources(GLContextResources&& rhs) = delete;
+    GLContextResources& operator = (GLContextResources&& rhs) = delete;
+
+    //-----------
+
+    void makeCurrent();
+
+    //delete all helpers, the context must be current
+    void release();
+
+    GLCopyEngine& getCopyEngine();
+    GLMipGenerator& getMipGenerator();
+    GLSwizzlePass& getSwizzlePass();
+    GLYUVPacker& getYUVPacker();
+
+    //current of the calling thread, the default instance of the thread if there is none
+    static GLContextResources& current();
+
+private:
+    std::unique_ptr<GLCopyEngine> m_copy_engine;
+    std::unique_ptr<GLMipGenerator> m_mip_generator;
+    std::unique_ptr<GLSwizzlePass> m_swizzle_pass;
+    std::unique_ptr<GLYUVPacker> m_yuv_packer;
+
+    static thread_local GLContextResources* s_current;
+};
+
+}//end of namespace luna
@@ -0,0 +1,239 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: texture to texture copy/scale/resolve with cached read & draw frame buffers
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+
+#include "gl_copy_engine.h"
+
+namespace luna {
+
+GLCopyEngine::~GLCopyEngine()
+{
+    this->destroy();
+}
+
+void GLCopyEngine::destroy()
+{
+    if (m_read_fbo_id != 0)
+    {
+        glDeleteFramebuffers(1, &m_read_fbo_id);
+        m_read_fbo_id = 0;
+    }
+
+    if (m_draw_fbo_id != 0)
+    {
+        glDeleteFramebuffers(1, &m_draw_fbo_id);
+        m_draw_fbo_id = 0;
+    }
+}
+
+GLCopyEngine::GLCopyEngine(GLCopyEngine&& rhs) noexcept
+{
+    m_read_fbo_id = rhs.m_read_fbo_id;
+    m_draw_fbo_id = rhs.m_draw_fbo_id;
+
+    rhs.m_read_fbo_id = 0;
+    rhs.m_draw_fbo_id = 0;
+}
+
+GLCopyEngine& GLCopyEngine::operator = (GLCopyEngine&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_read_fbo_id = rhs.m_read_fbo_id;
+    m_draw_fbo_id = rhs.m_draw_fbo_id;
+
+    rhs.m_read_fbo_id = 0;
+    rhs.m_draw_fbo_id = 0;
+
+    return *this;
+}
+
+bool GLCopyEngine::copy(const GLTexture& src, GLTexture& dst)
+{
+    if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight())
+    {
+        LOGE("error: size not match, src: %d x %d, dst: %d x %d", src.getWidth(), src.getHeight(), dst.getWidth(), dst.getHeight());
+        throw std::invalid_argument("error: size not match");
+        return false;
+    }
+
+    //dst takes over the row order of src, i.e. a raw copy stays possible
+    dst.setVerticalFlipped(src.isVerticalFlipped());
+
+    return this->copyRegion(src, cv::Rect(0, 0, src.getWidth(), src.getHeight()), dst, 0, 0);
+}
+
+bool GLCopyEngine::copyRegion(const GLTexture& src, const cv::Rect& src_rect, GLTexture& dst, int dst_x, int dst_y)
+{
+    const cv::Rect dst_rect(dst_x, dst_y, src_rect.width, src_rect.height);
+
+    checkRect(src, src_rect, "src");
+    checkRect(dst, dst_rect, "dst");
+
+    //raw texel copy, no fbo & no format conversion
+    const bool copy_image = isCopyImageSupported() &&
+                            src.getMultiSample() <= 1 && dst.getMultiSample() <= 1 &&
+                            src.isVerticalFlipped() == dst.isVerticalFlipped() &&
+                            src.getInternalFormat() != 0 && src.getInternalFormat() == dst.getInternalFormat();
+
+    if (copy_image)
+    {
+#if WIN32 || GL_ES_VERSION_3_2
+        glVerify(glCopyImageSubData(src.id(), GL_TEXTURE_2D, 0, src_rect.x, src_rect.y, 0,
+                                    dst.id(), GL_TEXTURE_2D, 0, dst_rect.x, dst_rect.y, 0,
+                                    src_rect.width, src_rect.height, 1));
+#endif
+        dst.markContentsChanged();
+        return true;
+    }
+
+    return this->blit(src, src_rect, dst, dst_rect, GL_NEAREST);
+}
+
+bool GLCopyEngine::blit(const GLTexture& src, const cv::Rect& src_rect, GLTexture& dst, const cv::Rect& dst_rect, GLenum filter)
+{
+    checkRect(src, src_rect, "src");
+    checkRect(dst, dst_rect, "dst");
+
+    if (dst.getMultiSample() > 1)
+    {
+        LOGE("error: can not blit into multi-sample texture");
+        throw std::invalid_argument("error: can not blit into multi-sample texture");
+        return false;
+    }
+
+    //NOTE: OpenGLES can not mirror while resolving, i.e. the row order must match as well
+    if (src.getMultiSample() > 1 && (src_rect != dst_rect || src.isVerticalFlipped() != dst.isVerticalFlipped()))
+    {
+        LOGE("error: multi-sample src can only be resolved into the same rectangle");
+        throw std::invalid_argument("error: multi-sample src can only be resolved into the same rectangle");
+        return false;
+    }
+
+    if (src.id() == dst.id())
+    {
+        LOGE("error: src and dst of blit must be different textures");
+        throw std::invalid_argument("error: src and dst of blit must be different textures");
+        return false;
+    }
+
+    //bindings of the caller are restored on return, e.g. a blit issued inside a render pass
+    GLFrameBufferBindingGuard binding_guard;
+
+    this->createFrameBuffers();
+
+    //NOTE: read buffer & draw buffers of a new fbo default to GL_COLOR_ATTACHMENT0, i.e. no glReadBuffer/glDrawBuffers
+    glVerify(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_read_fbo_id));
+    glVerify(glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, getTextureTarget(src), src.id(), 0));
+
+    glVerify(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_draw_fbo_id));
+    glVerify(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, dst.id(), 0));
+
+    //rows of a FLIP_TEXCOORD texture are stored upside down, reverse them if only one side is flipped
+    const bool flip_rows = (src.isVerticalFlipped() != dst.isVerticalFlipped());
+    const int dst_y0 = flip_rows ? dst_rect.y + dst_rect.height : dst_rect.y;
+    const int dst_y1 = flip_rows ? dst_rect.y : dst_rect.y + dst_rect.height;
+
+    glVerify(glBlitFramebuffer(src_rect.x, src_rect.y, src_rect.x + src_rect.width, src_rect.y + src_rect.height,
+                               dst_rect.x, dst_y0, dst_rect.x + dst_rect.width, dst_y1,
+                               GL_COLOR_BUFFER_BIT, src.getMultiSample() > 1 ? GL_NEAREST : filter));
+
+    //detach, i.e. cached fbos never keep deleted textures alive
+    glVerify(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0));
+    glVerify(glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, getTextureTarget(src), 0, 0));
+
+    dst.markContentsChanged();
+
+    return true;
+}
+
+bool GLCopyEngine::resolve(const GLTexture& src, GLTexture& dst)
+{
+    if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight())
+    {
+        LOGE("error: size not match, src: %d x %d, dst: %d x %d", src.getWidth(), src.getHeight(), dst.getWidth(), dst.getHeight());
+        throw std::invalid_argument("error: size not match");
+        return false;
+    }
+
+    const cv::Rect rect(0, 0, src.getWidth(), src.getHeight());
+
+    dst.setVerticalFlipped(src.isVerticalFlipped());
+
+    return this->blit(src, rect, dst, rect, GL_NEAREST);
+}
+
+bool GLCopyEngine::isCopyImageSupported()
+{
+#if WIN32 || GL_ES_VERSION_3_2
+    //headers may be newer than the context, check the context version once
+    static const bool supported = []()
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+#if GL_ES_VERSION_3_2
+        return major > 3 || (major == 3 && minor >= 2);
+#else
+        return major > 4 || (major == 4 && minor >= 3);
+#endif
+    }();
+
+    return supported;
+#else
+    //NOTE: macOS only supports OpenGL 4.1, OpenGLES 3.0/3.1 headers have no glCopyImageSubData
+    return false;
+#endif
+}
+
+void GLCopyEngine::createFrameBuffers()
+{
+    if (m_read_fbo_id == 0)
+        glVerify(glGenFramebuffers(1, &m_read_fbo_id));
+
+    if (m_draw_fbo_id == 0)
+        glVerify(glGenFramebuffers(1, &m_draw_fbo_id));
+}
+
+GLenum GLCopyEngine::getTextureTarget(const GLTexture& tex)
+{
+#if __IOS__
+    return GL_TEXTURE_2D;
+#else
+    return tex.getMultiSample() > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+#endif
+}
+
+void GLCopyEngine::checkRect(const GLTexture& tex, const cv::Rect& rect, const char* which)
+{
+    if (!tex.isValid())
+    {
+        LOGE("error: invalid %s texture", which);
+        throw std::invalid_argument("error: invalid texture");
+    }
+
+    if (rect.width <= 0 || rect.height <= 0 || rect.x < 0 || rect.y < 0 ||
+        rect.x + rect.width > tex.getWidth() || rect.y + rect.height > tex.getHeight())
+    {
+        LOGE("error: %s rect (%d, %d, %d, %d) is out of texture (%d x %d)", which,
+             rect.x, rect.y, rect.width, rect.height, tex.getWidth(), tex.getHeight());
+        throw std::invalid_argument("error: rect is out of texture");
+    }
+}
+
+}//end of namespace luna
@@ -0,0 +1,75 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: texture to texture copy/scale/resolve with cached read & draw frame buffers
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+namespace luna {
+
+class GLTexture;
+
+//NOTE: glCopyImageSubData (OpenGL 4.3 / OpenGLES 3.2) copies raw texels without any fbo, it is used when
+//      available and src/dst have the same known internal format and no multi-sample,
+//      otherwise glBlitFramebuffer through two cached fbos is used (scaling, format conversion, msaa resolve).
+//      Textures are attached to the cached fbos only during a copy, i.e. no fbo is created per copy.
+//      Rectangles are in texels, origin is the first texel of the texture (bottom-left in GL convention).
+
+class GLCopyEngine
+{
+public:
+
+    GLCopyEngine() = default;
+
+    ~GLCopyEngine();
+
+    void destroy();
+
+    //disable copy
+    GLCopyEngine(const GLCopyEngine& rhs) = delete;
+    GLCopyEngine& operator = (const GLCopyEngine& rhs) = delete;
+
+    //enable move
+    GLCopyEngine(GLCopyEngine&& rhs) noexcept;
+    GLCopyEngine& operator = (GLCopyEngine&& rhs) noexcept;
+
+    //-----------
+
+    //whole image, src and dst must have the same size, multi-sample src is resolved
+    //FLIP_TEXCOORD state (isVerticalFlipped) of src is carried over to dst, i.e. rows are copied as stored
+    bool copy(const GLTexture& src, GLTexture& dst);
+
+    //src_rect of src into dst at (dst_x, dst_y), no scaling
+    //NOTE: rects are in storage rows of each texture, rows are reversed if src & dst differ in isVerticalFlipped
+    bool copyRegion(const GLTexture& src, const cv::Rect& src_rect, GLTexture& dst, int dst_x, int dst_y);
+
+    //src_rect of src scaled into dst_rect of dst, filter: GL_LINEAR or GL_NEAREST (required for integer formats)
+    //NOTE: multi-sample src can not be scaled, src_rect and dst_rect must be identical (OpenGLES)
+    bool blit(const GLTexture& src, const cv::Rect& src_rect, GLTexture& dst, const cv::Rect& dst_rect, GLenum filter = GL_LINEAR);
+
+    //resolve multi-sample src into single-sample dst of the same size, FLIP_TEXCOORD state is carried over like copy
+    bool resolve(const GLTexture& src, GLTexture& dst);
+
+    //glCopyImageSubData is available in this build and by the current context
+    static bool isCopyImageSupported();
+
+private:
+
+    void createFrameBuffers();
+
+    static GLenum getTextureTarget(const GLTexture& tex);
+
+    static void checkRect(const GLTexture& tex, const cv::Rect& rect, const char* which);
+
+private:
+    GLuint m_read_fbo_id = 0;
+    GLuint m_draw_fbo_id = 0;
+};
+
+}//end of namespace luna
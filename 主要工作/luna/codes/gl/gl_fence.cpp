@@ -0,0 +1,95 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl fence sync object
+ * @version    : 1.0
+ */
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+
+#include "gl_fence.h"
+
+namespace luna {
+
+GLFence::GLFence(GLFence&& rhs) noexcept
+{
+    m_sync = rhs.m_sync;
+    rhs.m_sync = nullptr;
+}
+
+GLFence& GLFence::operator=(GLFence&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->destroy();
+
+        m_sync = rhs.m_sync;
+        rhs.m_sync = nullptr;
+    }
+    return *this;
+}
+
+GLFence::~GLFence()
+{
+    this->destroy();
+}
+
+void GLFence::destroy()
+{
+    if (m_sync != nullptr)
+    {
+        glDeleteSync(m_sync);
+        m_sync = nullptr;
+    }
+}
+
+void GLFence::insert()
+{
+    this->destroy();
+
+    m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (m_sync == nullptr)
+        LOGE("error: can not create fence sync");
+}
+
+bool GLFence::isSignaled() const
+{
+    if (m_sync == nullptr)
+        return true;
+
+    GLint status = GL_UNSIGNALED;
+    glGetSynciv(m_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+
+    return status == GL_SIGNALED;
+}
+
+bool GLFence::wait(uint64_t timeout_ns) const
+{
+    if (m_sync == nullptr)
+        return true;
+
+    //NOTE: flush commands, otherwise the fence may never be submitted and we wait forever
+    GLenum result = glClientWaitSync(m_sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+
+    if (result == GL_WAIT_FAILED)
+    {
+        LOGE("error: glClientWaitSync failed");
+        return false;
+    }
+
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+bool GLFence::isValid() const
+{
+    return m_sync != nullptr;
+}
+
+GLsync GLFence::id() const
+{
+    return m_sync;
+}
+
+}//end of namespace luna
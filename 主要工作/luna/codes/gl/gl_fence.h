@@ -0,0 +1,51 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl fence sync object
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "gl_include.h"
+
+namespace luna{
+
+class GLFence
+{
+public:
+
+    GLFence() = default;
+
+    ~GLFence();
+
+    //disable copy
+    GLFence(const GLFence& rhs) = delete;
+    GLFence& operator = (const GLFence& rhs) = delete;
+
+    //enable move
+    GLFence(GLFence&& rhs) noexcept;
+    GLFence& operator = (GLFence&& rhs) noexcept;
+
+    void destroy();
+
+    //insert a fence into command stream, previous fence is destroyed
+    void insert();
+
+    //non-blocking query, also returns true if no fence was inserted
+    bool isSignaled() const;
+
+    //block until signaled or timeout, returns true if signaled
+    bool wait(uint64_t timeout_ns = UINT64_MAX) const;
+
+    bool isValid() const;
+
+    GLsync id() const;
+
+private:
+    GLsync m_sync = nullptr;
+};
+
+}//end of namespace luna
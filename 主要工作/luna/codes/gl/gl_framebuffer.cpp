@@ -5,6 +5,7 @@
  * @version    : 1.0
  */
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -17,7 +18,12 @@
 
 #include "gl_utility.h"
 
+#include "gl_texture_array.h"
+#include "gl_texture_cubemap.h"
 #include "gl_framebuffer.h"
+#include "gl_yuv_packer.h"
+#include "gl_swizzle_pass.h"
+#include "gl_context_resources.h"
 
 namespace luna{
 
@@ -27,9 +33,10 @@ GLFrameBuffer::GLFrameBuffer(int width,
                              bool need_color,
                              bool use_float_color,
                              unsigned int multi_sample,
-                             unsigned int color_attachment_num)
+                             unsigned int color_attachment_num,
+                             bool use_render_buffer)
 {
-    bool succ = this->init(width, height, need_depth, need_color, use_float_color, multi_sample, color_attachment_num);
+    bool succ = this->init(width, height, need_depth, need_color, use_float_color, multi_sample, color_attachment_num, use_render_buffer);
     if (!succ)
     {
         LOGE("error: can not init GLFrameBuffer");
@@ -43,19 +50,169 @@ bool GLFrameBuffer::init(int width,
                          bool need_color,
                          bool use_float_color,
                          unsigned int multi_sample,
-                         unsigned int color_attachment_num)
+                         unsigned int color_attachment_num,
+                         bool use_render_buffer)
 {
+    GLint color_internal_format = GL_RGBA8;
+
+    if (use_float_color)
+    {
+#if __IOS__
+        //NOTE(Chen Wei): for ios opengles 3.0, only GL_RGBA16F is supported for FBO with float-type color attachment
+        color_internal_format = GL_RGBA16F;
+#else
+        color_internal_format = GL_RGBA32F;
+#endif
+    }
+
+    return this->init(width, height, need_depth, need_color, color_internal_format, multi_sample, color_attachment_num, use_render_buffer);
+}
+
+GLFrameBuffer::GLFrameBuffer(int width,
+                             int height,
+                             bool need_depth,
+                             bool need_color,
+                             GLint color_internal_format,
+                             unsigned int multi_sample,
+                             unsigned int color_attachment_num,
+                             bool use_render_buffer)
+{
+    bool succ = this->init(width, height, need_depth, need_color, color_internal_format, multi_sample, color_attachment_num, use_render_buffer);
+    if (!succ)
+    {
+        LOGE("error: can not init GLFrameBuffer");
+        throw std::invalid_argument("error: can not init GLFrameBuffer");
+    }
+}
+
+bool GLFrameBuffer::init(int width,
+                         int height,
+                         bool need_depth,
+                         bool need_color,
+                         GLint color_internal_format,
+                         unsigned int multi_sample,
+                         unsigned int color_attachment_num,
+                         bool use_render_buffer)
+{
+    GLDepthStencilDesc depth_stencil;
+    depth_stencil.internal_format = 0;
+
+    if (need_depth)
+    {
+        //former behavior: sampled unsized depth texture, render buffer if color samples are render buffers
+        const bool depth_render_buffer = use_render_buffer && multi_sample > 1;
+
+        depth_stencil.internal_format = depth_render_buffer ? GL_DEPTH_COMPONENT24 : GL_DEPTH_COMPONENT;
+        depth_stencil.storage = depth_render_buffer ? GLAttachmentStorage::RENDER_BUFFER : GLAttachmentStorage::TEXTURE;
+    }
+
+    return this->init(width, height, depth_stencil, color_internal_format, multi_sample,
+                      need_color ? color_attachment_num : 0, use_render_buffer);
+}
+
+GLFrameBuffer::GLFrameBuffer(int width,
+                             int height,
+                             const GLDepthStencilDesc& depth_stencil,
+                             GLint color_internal_format,
+                             unsigned int multi_sample,
+                             unsigned int color_attachment_num,
+                             bool use_render_buffer)
+{
+    bool succ = this->init(width, height, depth_stencil, color_internal_format, multi_sample, color_attachment_num, use_render_buffer);
+    if (!succ)
+    {
+        LOGE("error: can not init GLFrameBuffer");
+        throw std::invalid_argument("error: can not init GLFrameBuffer");
+    }
+}
+
+bool GLFrameBuffer::init(int width,
+                         int height,
+                         const GLDepthStencilDesc& depth_stencil,
+                         GLint color_internal_format,
+                         unsigned int multi_sample,
+                         unsigned int color_attachment_num,
+                         bool use_render_buffer)
+{
+    GLColorAttachmentDesc color_attachment;
+    color_attachment.internal_format = color_internal_format;
+    color_attachment.multi_sample = multi_sample;
+
+    GLDepthStencilDesc depth_stencil_attachment = depth_stencil;
+    depth_stencil_attachment.multi_sample = multi_sample;
+
+    return this->init(width, height, std::vector<GLColorAttachmentDesc>(color_attachment_num, color_attachment),
+                      depth_stencil_attachment, use_render_buffer);
+}
+
+GLFrameBuffer::GLFrameBuffer(int width,
+                             int height,
+                             const std::vector<GLColorAttachmentDesc>& color_attachments,
+                             const GLDepthStencilDesc& depth_stencil,
+                             bool use_render_buffer)
+{
+    bool succ = this->init(width, height, color_attachments, depth_stencil, use_render_buffer);
+    if (!succ)
+    {
+        LOGE("error: can not init GLFrameBuffer");
+        throw std::invalid_argument("error: can not init GLFrameBuffer");
+    }
+}
+
+bool GLFrameBuffer::init(int width,
+                         int height,
+                         const std::vector<GLColorAttachmentDesc>& color_attachments,
+                         const GLDepthStencilDesc& depth_stencil,
+                         bool use_render_buffer)
+{
+    //NOTE: all attachments of a fbo must have the same sample count, otherwise it is incomplete
+    //      (GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE), so per-attachment sample counts are checked here
+    unsigned int multi_sample = color_attachments.empty() ? depth_stencil.multi_sample : color_attachments[0].multi_sample;
+
+    for (const GLColorAttachmentDesc& color_attachment : color_attachments)
+    {
+        if (color_attachment.multi_sample != multi_sample)
+        {
+            LOGE("error: color attachments have different sample counts (%d vs %d)", color_attachment.multi_sample, multi_sample);
+            throw std::invalid_argument("error: color attachments have different sample counts");
+            return false;
+        }
+    }
+
+    if (depth_stencil.hasDepth() && depth_stencil.multi_sample != multi_sample)
+    {
+        LOGE("error: depth/stencil sample count (%d) differs from color (%d)", depth_stencil.multi_sample, multi_sample);
+        throw std::invalid_argument("error: depth/stencil sample count differs from color");
+        return false;
+    }
+
+    const unsigned int color_attachment_num = static_cast<unsigned int>(color_attachments.size());
+
+    //copy first, color_attachments/depth_stencil may refer to the members cleared by destroy(),
+    //i.e. only the copies are used from here on
+    const std::vector<GLColorAttachmentDesc> color_attachment_descs = color_attachments;
+    const GLDepthStencilDesc depth_stencil_desc = depth_stencil;
+
     //destroy if necessary
     this->destroy();
 
     m_width = width;
     m_height = height;
 
+    m_capacity_width = width;
+    m_capacity_height = height;
+
+    //kept for resize()
+    m_color_attachment_descs = color_attachment_descs;
+    m_depth_stencil_desc = depth_stencil_desc;
+    m_use_render_buffer = use_render_buffer;
+    m_resizable = true;
+
     glGenFramebuffers(1, &m_fbo_id);
     glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id);
 
 #if __IOS__
-    if (multi_sample > 1)
+    if (multi_sample > 1 && !use_render_buffer)
     {
         multi_sample = 1;
         LOGE("Error: IOS don't support multi-sample texture, replaced by non-multi-sample texture");
@@ -66,219 +223,898 @@ bool GLFrameBuffer::init(int width,
     GLenum target = multi_sample > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 #endif
 
-    if (need_color)
+    //single-sample attachments stay textures, i.e. they can be sampled directly
+    use_render_buffer = use_render_buffer && multi_sample > 1;
+
+    m_multi_sample = multi_sample > 1 ? multi_sample : 1;
+    m_resolve_dirty = true;
+
+    if (color_attachment_num > 0)
     {
         GLint MAX_COLOR_ATTACHMENTS;
         glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &MAX_COLOR_ATTACHMENTS);
 
-        if (MAX_COLOR_ATTACHMENTS < color_attachment_num)
-        {
-            LOGE("error: MAX_COLOR_ATTACHMENTS(%d) is less than color_attachment_num(%d)", MAX_COLOR_ATTACHMENTS, color_attachment_num);
-            throw std::invalid_argument("error: MAX_COLOR_ATTACHMENTS is less than color_attachment_num");
-            return false;
-        }
+        if (MAX_COLOR_ATTACHMENTS < color_attachment_num)
+        {
+            LOGE("error: MAX_COLOR_ATTACHMENTS(%d) is less than color_attachment_num(%d)", MAX_COLOR_ATTACHMENTS, color_attachment_num);
+            throw std::invalid_argument("error: MAX_COLOR_ATTACHMENTS is less than color_attachment_num");
+            return false;
+        }
+
+        //NOTE: prefer GL_RGBA16F/GL_R11F_G11F_B10F over GL_RGBA32F for HDR intermediates (1/2 or 1/4 of the bandwidth),
+        //      float color attachments need EXT_color_buffer_float (or EXT_color_buffer_half_float) on OpenGLES
+        if (use_render_buffer)
+        {
+            m_color_render_buffers.resize(color_attachment_num);
+            for (unsigned int i = 0; i < color_attachment_num; ++i)
+            {
+                m_color_render_buffers[i].init(m_width, m_height, color_attachment_descs[i].internal_format, multi_sample);
+                glVerify(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER, m_color_render_buffers[i].id()));
+            }
+
+            //may be clamped to GL_MAX_SAMPLES
+            m_multi_sample = m_color_render_buffers[0].getMultiSample();
+        }
+        else
+        {
+            m_fbo_color_tex_vec.resize(color_attachment_num);
+            for (unsigned int i = 0; i < color_attachment_num; ++i)
+            {
+                m_fbo_color_tex_vec[i].allocate(m_width, m_height, color_attachment_descs[i].internal_format, multi_sample, color_attachment_descs[i].mip_levels);
+
+                m_fbo_color_tex_vec[i].bind();
+                glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, target, m_fbo_color_tex_vec[i].id(), 0));
+                m_fbo_color_tex_vec[i].unbind();
+            }
+        }
+    }
+
+    GLAttachmentStorage depth_storage = depth_stencil_desc.storage;
+
+#if __IOS__
+    if (depth_stencil_desc.hasDepth() && multi_sample > 1 && depth_storage == GLAttachmentStorage::TEXTURE)
+    {
+        depth_storage = GLAttachmentStorage::RENDER_BUFFER;
+        LOGE("Error: IOS don't support multi-sample texture, depth is replaced by render buffer");
+    }
+#endif
+
+    m_depth_stencil_format = depth_stencil_desc.internal_format;
+
+    //packed depth-stencil is a single image attached to both attachment points
+    const GLenum depth_attachment = depth_stencil_desc.hasStencil() ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+    if (!depth_stencil_desc.hasDepth())
+    {
+        //no depth & stencil
+    }
+    else if (depth_storage == GLAttachmentStorage::RENDER_BUFFER)
+    {
+        m_depth_render_buffer.init(m_width, m_height, GLTexture::getSizedInternalFormat(depth_stencil_desc.internal_format), multi_sample);
+        glVerify(glFramebufferRenderbuffer(GL_FRAMEBUFFER, depth_attachment, GL_RENDERBUFFER, m_depth_render_buffer.id()));
+    }
+    else
+    {
+        if (depth_stencil_desc.internal_format == GL_DEPTH_COMPONENT)
+        {
+#if __ANDROID__
+            //NOTE(Chen Wei): use float-type depth texture for android get wrong result, why ?
+            m_fbo_depth_tex.init(m_width, m_height, GL_DEPTH_COMPONENT, static_cast<unsigned char*>(nullptr), multi_sample);
+#else
+            m_fbo_depth_tex.init(m_width, m_height, GL_DEPTH_COMPONENT, static_cast<float*>(nullptr), multi_sample);
+#endif
+        }
+        else
+        {
+            m_fbo_depth_tex.allocate(m_width, m_height, depth_stencil_desc.internal_format, multi_sample);
+
+            //NOTE: depth textures are not filterable on OpenGLES (without compare mode)
+            if (m_fbo_depth_tex.getMultiSample() <= 1)
+                m_fbo_depth_tex.setFilter(GL_NEAREST, GL_NEAREST);
+        }
+
+        m_fbo_depth_tex.bind();
+        glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, depth_attachment, target, m_fbo_depth_tex.id(), 0));
+        m_fbo_depth_tex.unbind();
+    }
+
+    this->bindDrawBuffers();
+
+    //check frame buffer status
+    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LOGE("error: FBO is incomplete !");
+        throw std::runtime_error("error: FBO is incomplete !");
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+bool GLFrameBuffer::init(const GLTexture& color_tex, int mip_level)
+{
+    if (mip_level < 0 || mip_level >= color_tex.getMipLevels())
+    {
+        LOGE("error: invalid mip level %d of %d levels", mip_level, color_tex.getMipLevels());
+        throw std::invalid_argument("error: invalid mip level");
+        return false;
+    }
+
+    return this->init(color_tex.id(), color_tex.getLevelWidth(mip_level), color_tex.getLevelHeight(mip_level), mip_level);
+}
+
+bool GLFrameBuffer::init(GLuint color_tex_id, int width, int height, int mip_level)
+{
+    //destroy if necessary
+    this->destroy();
+
+    m_width = width;
+    m_height = height;
+
+    m_capacity_width = width;
+    m_capacity_height = height;
+
+    //NOTE(Chen Wei): not supported by OpenGL ES 3.0 & lower, need further consideration
+    // glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_2D, &m_width);
+    // glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &m_height);
+
+    glGenFramebuffers(1, &m_fbo_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id);
+
+    GLTexture color_tex;
+    color_tex.wrap(color_tex_id, m_width, m_height, mip_level);
+
+    color_tex.bind();
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_tex_id, mip_level);
+    color_tex.unbind();
+
+    m_fbo_color_tex_vec.push_back(std::move(color_tex));
+
+    this->bindDrawBuffers();
+
+    //check frame buffer status
+    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LOGE("error: FBO is incomplete !");
+        std::exit(EXIT_FAILURE);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+bool GLFrameBuffer::init(const std::vector<const GLTexture*>& color_texs)
+{
+    if (color_texs.empty())
+    {
+        LOGE("error: no color texture to attach");
+        throw std::invalid_argument("error: no color texture to attach");
+        return false;
+    }
+
+    GLint MAX_COLOR_ATTACHMENTS;
+    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &MAX_COLOR_ATTACHMENTS);
+
+    if (MAX_COLOR_ATTACHMENTS < static_cast<GLint>(color_texs.size()))
+    {
+        LOGE("error: MAX_COLOR_ATTACHMENTS(%d) is less than color texture num(%d)", MAX_COLOR_ATTACHMENTS, static_cast<int>(color_texs.size()));
+        throw std::invalid_argument("error: MAX_COLOR_ATTACHMENTS is less than color texture num");
+        return false;
+    }
+
+    for (const GLTexture* color_tex : color_texs)
+    {
+        if (color_tex == nullptr || !color_tex->isValid() ||
+            color_tex->getWidth() != color_texs[0]->getWidth() || color_tex->getHeight() != color_texs[0]->getHeight())
+        {
+            LOGE("error: color textures must be valid and have the same size");
+            throw std::invalid_argument("error: color textures must be valid and have the same size");
+            return false;
+        }
+    }
+
+    //destroy if necessary
+    this->destroy();
+
+    m_width = color_texs[0]->getWidth();
+    m_height = color_texs[0]->getHeight();
+
+    m_capacity_width = m_width;
+    m_capacity_height = m_height;
+
+    glGenFramebuffers(1, &m_fbo_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id);
+
+    m_fbo_color_tex_vec.resize(color_texs.size());
+    for (unsigned int i = 0; i < color_texs.size(); ++i)
+    {
+        m_fbo_color_tex_vec[i].wrap(color_texs[i]->id(), m_width, m_height);
+        glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, color_texs[i]->id(), 0));
+    }
+
+    this->bindDrawBuffers();
+
+    //check frame buffer status
+    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LOGE("error: FBO is incomplete !");
+        throw std::runtime_error("error: FBO is incomplete !");
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+bool GLFrameBuffer::init(const GLTextureArray& tex_array)
+{
+    if (!tex_array.isValid())
+    {
+        LOGE("error: invalid texture array");
+        throw std::invalid_argument("error: invalid texture array");
+        return false;
+    }
+
+    return this->initLayered(GL_TEXTURE_2D_ARRAY, tex_array.id(), tex_array.getWidth(), tex_array.getHeight(), tex_array.getLayerNum());
+}
+
+bool GLFrameBuffer::init(const GLTextureCubeMap& cubemap)
+{
+    if (!cubemap.isValid() || cubemap.getSize() <= 0)
+    {
+        LOGE("error: invalid cubemap, allocate it by GLTextureCubeMap::init(size, internal_format)");
+        throw std::invalid_argument("error: invalid cubemap");
+        return false;
+    }
+
+    return this->initLayered(GL_TEXTURE_CUBE_MAP, cubemap.id(), cubemap.getSize(), cubemap.getSize(), 6);
+}
+
+bool GLFrameBuffer::initLayered(GLenum target, GLuint tex_id, int width, int height, int layer_num)
+{
+    //destroy if necessary
+    this->destroy();
+
+    m_width = width;
+    m_height = height;
+
+    m_capacity_width = width;
+    m_capacity_height = height;
+
+    m_layered_tex_id = tex_id;
+    m_layered_target = target;
+    m_layer_num = layer_num;
+
+    glGenFramebuffers(1, &m_fbo_id);
+
+    this->attachLayer(isLayeredRenderingSupported() ? -1 : 0);
+
+    this->bindDrawBuffers();
+
+    //check frame buffer status
+    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LOGE("error: FBO is incomplete !");
+        throw std::runtime_error("error: FBO is incomplete !");
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+bool GLFrameBuffer::attachLayer(int layer)
+{
+    if (m_layered_tex_id == 0)
+    {
+        LOGE("error: no layered texture is attached");
+        throw std::runtime_error("error: no layered texture is attached");
+        return false;
+    }
+
+    if (layer < -1 || layer >= m_layer_num || (layer == -1 && !isLayeredRenderingSupported()))
+    {
+        LOGE("error: invalid layer: %d, layer num: %d", layer, m_layer_num);
+        throw std::invalid_argument("error: invalid layer");
+        return false;
+    }
+
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id));
+
+    if (m_in_render_pass && m_render_pass.getColorAction(0).store_action == GLStoreAction::DISCARD)
+        invalidateAttachments({GL_COLOR_ATTACHMENT0});
+
+    if (layer == -1)
+    {
+#if WIN32 || __MACOS__
+        glVerify(glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_layered_tex_id, 0));
+#endif
+    }
+    else if (m_layered_target == GL_TEXTURE_CUBE_MAP)
+    {
+        glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, m_layered_tex_id, 0));
+    }
+    else
+    {
+        glVerify(glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_layered_tex_id, 0, layer));
+    }
+
+    m_attached_layer = layer;
+
+    if (m_in_render_pass)
+    {
+        const GLColorAttachmentAction& action = m_render_pass.getColorAction(0);
+        if (action.load_action == GLLoadAction::DONT_CARE)
+            invalidateAttachments({GL_COLOR_ATTACHMENT0});
+        else if (action.load_action == GLLoadAction::CLEAR)
+            glVerify(glClearBufferfv(GL_COLOR, 0, glm::value_ptr(action.clear_color)));
+    }
+
+    return true;
+}
+
+int GLFrameBuffer::getLayerNum() const
+{
+    return m_layer_num;
+}
+
+int GLFrameBuffer::getAttachedLayer() const
+{
+    return m_attached_layer;
+}
+
+bool GLFrameBuffer::isLayeredRenderingSupported()
+{
+#if WIN32 || __MACOS__
+    return true;
+#else
+    //NOTE: GLShader compiles vertex & fragment shaders only on OpenGLES, i.e. no geometry shader writes gl_Layer
+    return false;
+#endif
+}
+
+GLFrameBuffer::GLFrameBuffer(GLFrameBuffer&& rhs) noexcept
+{
+    m_fbo_id = rhs.m_fbo_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+
+    m_fbo_color_tex_vec = std::move(rhs.m_fbo_color_tex_vec);
+    m_fbo_depth_tex = std::move(rhs.m_fbo_depth_tex);
+
+    m_color_render_buffers = std::move(rhs.m_color_render_buffers);
+    m_depth_render_buffer = std::move(rhs.m_depth_render_buffer);
+
+    m_capacity_width = rhs.m_capacity_width;
+    m_capacity_height = rhs.m_capacity_height;
+
+    m_color_attachment_descs = std::move(rhs.m_color_attachment_descs);
+    m_depth_stencil_desc = rhs.m_depth_stencil_desc;
+    m_use_render_buffer = rhs.m_use_render_buffer;
+    m_resizable = rhs.m_resizable;
+
+    m_layered_tex_id = rhs.m_layered_tex_id;
+    m_layered_target = rhs.m_layered_target;
+    m_layer_num = rhs.m_layer_num;
+    m_attached_layer = rhs.m_attached_layer;
+
+    m_multi_sample = rhs.m_multi_sample;
+    m_depth_stencil_format = rhs.m_depth_stencil_format;
+    m_resolve_fbo = std::move(rhs.m_resolve_fbo);
+    m_resolve_dirty = rhs.m_resolve_dirty;
+
+    //a pass begun on rhs is ended on this
+    m_render_pass = rhs.m_render_pass;
+    m_in_render_pass = rhs.m_in_render_pass;
+
+    rhs.m_fbo_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_capacity_width = 0;
+    rhs.m_capacity_height = 0;
+    rhs.m_resizable = false;
+    rhs.m_layered_tex_id = 0;
+    rhs.m_layered_target = 0;
+    rhs.m_layer_num = 0;
+    rhs.m_attached_layer = -1;
+    rhs.m_multi_sample = 1;
+    rhs.m_depth_stencil_format = 0;
+    rhs.m_render_pass = GLRenderPass();
+    rhs.m_in_render_pass = false;
+}
+
+GLFrameBuffer& GLFrameBuffer::operator = (GLFrameBuffer&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_fbo_id = rhs.m_fbo_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+
+    m_fbo_color_tex_vec = std::move(rhs.m_fbo_color_tex_vec);
+    m_fbo_depth_tex = std::move(rhs.m_fbo_depth_tex);
+
+    m_color_render_buffers = std::move(rhs.m_color_render_buffers);
+    m_depth_render_buffer = std::move(rhs.m_depth_render_buffer);
+
+    m_capacity_width = rhs.m_capacity_width;
+    m_capacity_height = rhs.m_capacity_height;
+
+    m_color_attachment_descs = std::move(rhs.m_color_attachment_descs);
+    m_depth_stencil_desc = rhs.m_depth_stencil_desc;
+    m_use_render_buffer = rhs.m_use_render_buffer;
+    m_resizable = rhs.m_resizable;
+
+    m_layered_tex_id = rhs.m_layered_tex_id;
+    m_layered_target = rhs.m_layered_target;
+    m_layer_num = rhs.m_layer_num;
+    m_attached_layer = rhs.m_attached_layer;
+
+    m_multi_sample = rhs.m_multi_sample;
+    m_depth_stencil_format = rhs.m_depth_stencil_format;
+    m_resolve_fbo = std::move(rhs.m_resolve_fbo);
+    m_resolve_dirty = rhs.m_resolve_dirty;
+
+    //a pass begun on rhs is ended on this
+    m_render_pass = rhs.m_render_pass;
+    m_in_render_pass = rhs.m_in_render_pass;
+
+    rhs.m_fbo_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_capacity_width = 0;
+    rhs.m_capacity_height = 0;
+    rhs.m_resizable = false;
+    rhs.m_layered_tex_id = 0;
+    rhs.m_layered_target = 0;
+    rhs.m_layer_num = 0;
+    rhs.m_attached_layer = -1;
+    rhs.m_multi_sample = 1;
+    rhs.m_depth_stencil_format = 0;
+    rhs.m_render_pass = GLRenderPass();
+    rhs.m_in_render_pass = false;
+
+    return *this;
+}
+
+GLFrameBuffer::~GLFrameBuffer()
+{
+    this->destroy();
+}
+
+void GLFrameBuffer::destroy()
+{
+    if (m_fbo_id != 0)
+    {
+        glDeleteFramebuffers(1, &m_fbo_id);
+        m_fbo_id = 0;
+
+        m_width = 0;
+        m_height = 0;
+
+        m_capacity_width = 0;
+        m_capacity_height = 0;
+
+        m_color_attachment_descs.clear();
+        m_resizable = false;
+
+        m_layered_tex_id = 0;
+        m_layered_target = 0;
+        m_layer_num = 0;
+        m_attached_layer = -1;
+
+        m_fbo_color_tex_vec.clear();
+        m_fbo_depth_tex.destroy();
+
+        m_color_render_buffers.clear();
+        m_depth_render_buffer.destroy();
+
+        m_multi_sample = 1;
+        m_depth_stencil_format = 0;
+        m_resolve_fbo.reset();
+        m_resolve_dirty = true;
+
+        m_in_render_pass = false;
+    }
+}
+
+void GLFrameBuffer::bind(bool set_viewport, bool clear_color_depth) const
+{
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id));
+
+    //bound for rendering, multi-sample contents need to be resolved again
+    this->markContentsChanged();
+
+    if (set_viewport)
+        glViewport(0, 0, m_width, m_height);
+
+    if (clear_color_depth)
+    {
+        glClearDepthf(1.0);
+        glClearColor(0.0, 0.0, 0.0, 1.0);
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+}
+
+void GLFrameBuffer::unbind() const
+{
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+
+    //error: Invalid Operation, why ?
+    //GLuint attachments[] = {GL_COLOR_ATTACHMENT0};
+    //glVerify(glDrawBuffers(1, attachments));
+}
+
+//NOTE: draw buffers are per-fbo state, i.e. set once while the fbo is bound in init(), not on every bind
+void GLFrameBuffer::bindDrawBuffers() const
+{
+    std::vector<GLuint> attachments;
+    for (unsigned int i = 0; i < this->getColorAttachmentNum(); ++i)
+        attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+
+    glVerify(glDrawBuffers(attachments.size(), attachments.data()));
+}
+
+void GLFrameBuffer::invalidateAttachments(const std::vector<GLenum>& attachments)
+{
+    if (attachments.empty())
+        return;
+
+#if __MACOS__
+    //NOTE: macOS only supports OpenGL 4.1, glInvalidateFramebuffer (4.3) is not available,
+    //      and macOS is not a tile-based platform, just skip it
+#else
+    glVerify(glInvalidateFramebuffer(GL_FRAMEBUFFER, attachments.size(), attachments.data()));
+#endif
+}
+
+void GLFrameBuffer::beginRenderPass(const GLRenderPass& render_pass, bool set_viewport)
+{
+    if (m_fbo_id == 0)
+    {
+        LOGE("error: invalid fbo id: %d", m_fbo_id);
+        throw std::invalid_argument("error: invalid fbo id");
+    }
+
+    if (m_in_render_pass)
+    {
+        LOGE("error: render pass already begun, call endRenderPass() first");
+        throw std::runtime_error("error: render pass already begun");
+    }
+
+    m_render_pass = render_pass;
+    m_in_render_pass = true;
+
+    this->markContentsChanged();
+
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id));
+
+    if (set_viewport)
+        glViewport(0, 0, m_width, m_height);
+
+    const bool has_depth = this->hasDepth();
+
+    //DONT_CARE: tell driver not to load tile memory from system memory
+    std::vector<GLenum> invalid_attachments;
+    for (unsigned int i = 0; i < this->getColorAttachmentNum(); ++i)
+    {
+        if (render_pass.getColorAction(i).load_action == GLLoadAction::DONT_CARE)
+            invalid_attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+
+    if (has_depth && render_pass.depth_action.load_action == GLLoadAction::DONT_CARE)
+        invalid_attachments.push_back(GL_DEPTH_ATTACHMENT);
+
+    if (this->hasStencil() && render_pass.stencil_action.load_action == GLLoadAction::DONT_CARE)
+        invalid_attachments.push_back(GL_STENCIL_ATTACHMENT);
+
+    invalidateAttachments(invalid_attachments);
+
+    //CLEAR: per-attachment clear, a full clear is also treated as "no load" by tile-based GPUs
+    for (unsigned int i = 0; i < this->getColorAttachmentNum(); ++i)
+    {
+        const GLColorAttachmentAction& action = render_pass.getColorAction(i);
+        if (action.load_action == GLLoadAction::CLEAR)
+            glVerify(glClearBufferfv(GL_COLOR, i, glm::value_ptr(action.clear_color)));
+    }
+
+    if (has_depth && render_pass.depth_action.load_action == GLLoadAction::CLEAR)
+        glVerify(glClearBufferfv(GL_DEPTH, 0, &render_pass.depth_action.clear_depth));
+
+    if (this->hasStencil() && render_pass.stencil_action.load_action == GLLoadAction::CLEAR)
+        glVerify(glClearBufferiv(GL_STENCIL, 0, &render_pass.stencil_action.clear_stencil));
+}
+
+void GLFrameBuffer::endRenderPass()
+{
+    if (!m_in_render_pass)
+    {
+        LOGE("error: render pass not begun, call beginRenderPass() first");
+        throw std::runtime_error("error: render pass not begun");
+    }
+
+    //DISCARD: tell driver not to store tile memory to system memory
+    std::vector<GLenum> invalid_attachments;
+    for (unsigned int i = 0; i < this->getColorAttachmentNum(); ++i)
+    {
+        if (m_render_pass.getColorAction(i).store_action == GLStoreAction::DISCARD)
+            invalid_attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+
+    if (this->hasDepth() && m_render_pass.depth_action.store_action == GLStoreAction::DISCARD)
+        invalid_attachments.push_back(GL_DEPTH_ATTACHMENT);
+
+    if (this->hasStencil() && m_render_pass.stencil_action.store_action == GLStoreAction::DISCARD)
+        invalid_attachments.push_back(GL_STENCIL_ATTACHMENT);
+
+    invalidateAttachments(invalid_attachments);
+
+    m_in_render_pass = false;
+
+    this->unbind();
+}
+
+bool GLFrameBuffer::resize(int width, int height, bool grow_only)
+{
+    if (!m_resizable)
+    {
+        LOGE("error: fbo wrapping external textures can not be resized");
+        throw std::runtime_error("error: fbo wrapping external textures can not be resized");
+        return false;
+    }
 
-        m_fbo_color_tex_vec.resize(color_attachment_num);
-        for (unsigned int i = 0; i < color_attachment_num; ++i)
-        {
-            if (use_float_color)
-            {
-                m_fbo_color_tex_vec[i].init(m_width, m_height, GL_RGBA, static_cast<float*>(nullptr), multi_sample);
-#if __IOS__
-                //NOTE(Chen Wei): for ios opengles 3.0, only GL_RGBA16F is supported for FBO with float-type color attachment
-                m_fbo_color_tex_vec[i].bind();
-                glVerify(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr));
-                m_fbo_color_tex_vec[i].unbind();
-                
-#endif
-            }
-            else
-            {
-                m_fbo_color_tex_vec[i].init(m_width, m_height, GL_RGBA, static_cast<unsigned char*>(nullptr), multi_sample);
-            }
+    if (width <= 0 || height <= 0)
+    {
+        LOGE("error: invalid fbo size: %d x %d", width, height);
+        throw std::invalid_argument("error: invalid fbo size");
+        return false;
+    }
 
-            m_fbo_color_tex_vec[i].bind();
-            glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, target, m_fbo_color_tex_vec[i].id(), 0));
-            m_fbo_color_tex_vec[i].unbind();
-        }
+    if (m_in_render_pass)
+    {
+        LOGE("error: can not resize fbo inside a render pass");
+        throw std::runtime_error("error: can not resize fbo inside a render pass");
+        return false;
     }
 
-    if (need_depth)
+    if (width == m_width && height == m_height && (grow_only || (width == m_capacity_width && height == m_capacity_height)))
+        return true;
+
+    //fits into current allocation, only the rendered sub-rectangle changes
+    if (grow_only && width <= m_capacity_width && height <= m_capacity_height)
     {
-#if __ANDROID__
-        //NOTE(Chen Wei): use float-type depth texture for android get wrong result, why ?
-        m_fbo_depth_tex.init(m_width, m_height, GL_DEPTH_COMPONENT, static_cast<unsigned char*>(nullptr), multi_sample);
-#else
-        m_fbo_depth_tex.init(m_width, m_height, GL_DEPTH_COMPONENT, static_cast<float*>(nullptr), multi_sample);
-#endif
+        m_width = width;
+        m_height = height;
 
-        m_fbo_depth_tex.bind();
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, target, m_fbo_depth_tex.id(), 0);
-        m_fbo_depth_tex.unbind();
+        m_resolve_dirty = true;
+
+        return true;
     }
 
-    //check frame buffer status
-    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    //NOTE: growth is rounded up to RESIZE_GRANULARITY, i.e. dragging a window edge reallocates
+    //      once every few dozen pixels instead of every frame
+    int capacity_width = width;
+    int capacity_height = height;
+    if (grow_only)
     {
-        LOGE("error: FBO is incomplete !");
-        throw std::runtime_error("error: FBO is incomplete !");
+        capacity_width = std::max(m_capacity_width, (width + RESIZE_GRANULARITY - 1) / RESIZE_GRANULARITY * RESIZE_GRANULARITY);
+        capacity_height = std::max(m_capacity_height, (height + RESIZE_GRANULARITY - 1) / RESIZE_GRANULARITY * RESIZE_GRANULARITY);
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    //copy, init() clears the descriptors
+    const std::vector<GLColorAttachmentDesc> color_attachments = m_color_attachment_descs;
+    const GLDepthStencilDesc depth_stencil = m_depth_stencil_desc;
+
+    this->init(capacity_width, capacity_height, color_attachments, depth_stencil, m_use_render_buffer);
+
+    m_width = width;
+    m_height = height;
 
     return true;
 }
 
-bool GLFrameBuffer::init(const GLTexture& color_tex)
+int GLFrameBuffer::getCapacityWidth() const
 {
-    return this->init(color_tex.id(), color_tex.getWidth(), color_tex.getHeight());
+    return m_capacity_width;
 }
 
-bool GLFrameBuffer::init(GLuint color_tex_id, int width, int height)
+int GLFrameBuffer::getCapacityHeight() const
 {
-    //destroy if necessary
-    this->destroy();
+    return m_capacity_height;
+}
 
-    m_width = width;
-    m_height = height;
+glm::vec2 GLFrameBuffer::getTexCoordScale() const
+{
+    if (m_capacity_width <= 0 || m_capacity_height <= 0)
+        return glm::vec2(1.0f, 1.0f);
 
-    //NOTE(Chen Wei): not supported by OpenGL ES 3.0 & lower, need further consideration
-    // glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_2D, &m_width);
-    // glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &m_height);
+    return glm::vec2(static_cast<float>(m_width) / m_capacity_width, static_cast<float>(m_height) / m_capacity_height);
+}
 
-    glGenFramebuffers(1, &m_fbo_id);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id);
+bool GLFrameBuffer::hasSlack() const
+{
+    return m_width != m_capacity_width || m_height != m_capacity_height;
+}
 
-    GLTexture color_tex;
-    color_tex.wrap(color_tex_id, m_width, m_height);
+GLuint GLFrameBuffer::id() const
+{
+    return m_fbo_id;
+}
 
-    color_tex.bind();
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_tex_id, 0);
-    color_tex.unbind();
+GLTexture& GLFrameBuffer::getColorTex(int id)
+{
+    this->checkColorTex(id);
 
-    m_fbo_color_tex_vec.push_back(std::move(color_tex));
+    //render buffers can not be sampled, hand out the resolved texture instead
+    if (this->useRenderBuffer())
+        return this->getResolveFrameBuffer().getColorTex(id);
 
-    //check frame buffer status
-    if (openGLCheckCurFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-    {
-        LOGE("error: FBO is incomplete !");
-        std::exit(EXIT_FAILURE);
-    }
+    return m_fbo_color_tex_vec[id];
+}
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+const GLTexture & GLFrameBuffer::getColorTex(int id) const
+{
+    this->checkColorTex(id);
 
-    return true;
+    if (this->useRenderBuffer())
+        return this->getResolveFrameBuffer().getColorTex(id);
+
+    return m_fbo_color_tex_vec[id];
 }
 
-GLFrameBuffer::GLFrameBuffer(GLFrameBuffer&& rhs) noexcept
+std::vector<GLTexture>& GLFrameBuffer::getColorTexVec()
 {
-    m_fbo_id = rhs.m_fbo_id;
-    m_width = rhs.m_width;
-    m_height = rhs.m_height;
+    if (this->useRenderBuffer())
+        return this->getResolveFrameBuffer().getColorTexVec();
 
-    m_fbo_color_tex_vec = std::move(rhs.m_fbo_color_tex_vec);
-    m_fbo_depth_tex = std::move(rhs.m_fbo_depth_tex);
+    return m_fbo_color_tex_vec;
+}
 
-    rhs.m_fbo_id = 0;
-    rhs.m_width = 0;
-    rhs.m_height = 0;
+const std::vector<GLTexture>& GLFrameBuffer::getColorTexVec() const
+{
+    if (this->useRenderBuffer())
+        return this->getResolveFrameBuffer().getColorTexVec();
+
+    return m_fbo_color_tex_vec;
 }
 
-GLFrameBuffer& GLFrameBuffer::operator = (GLFrameBuffer&& rhs) noexcept
+void GLFrameBuffer::checkColorTex(int id) const
 {
-    if (this == &rhs)
-        return *this;
+    if (m_layered_tex_id != 0)
+    {
+        LOGE("error: layered fbo has no color GLTexture, sample the GLTextureArray/GLTextureCubeMap instead");
+        throw std::runtime_error("error: layered fbo has no color GLTexture");
+    }
 
-    this->destroy();
+    if (id < 0 || id >= static_cast<int>(this->getColorAttachmentNum()))
+    {
+        LOGE("error: invalid color attachment id: %d, color attachment num: %d", id, this->getColorAttachmentNum());
+        throw std::invalid_argument("error: invalid color attachment id");
+    }
+}
 
-    m_fbo_id = rhs.m_fbo_id;
-    m_width = rhs.m_width;
-    m_height = rhs.m_height;
+const GLTexture& GLFrameBuffer::getResolvedColorTex(int id) const
+{
+    return this->resolve().getColorTex(id);
+}
 
-    m_fbo_color_tex_vec = std::move(rhs.m_fbo_color_tex_vec);
-    m_fbo_depth_tex = std::move(rhs.m_fbo_depth_tex);
+const GLFrameBuffer& GLFrameBuffer::resolve() const
+{
+    if (m_multi_sample <= 1)
+        return *this;
 
-    rhs.m_fbo_id = 0;
-    rhs.m_width = 0;
-    rhs.m_height = 0;
+    return this->getResolveFrameBuffer();
+}
 
-    return *this;
+void GLFrameBuffer::markContentsChanged() const
+{
+    m_resolve_dirty = true;
+
+    for (const GLTexture& color_tex : m_fbo_color_tex_vec)
+        color_tex.markContentsChanged();
 }
 
-GLFrameBuffer::~GLFrameBuffer()
+unsigned int GLFrameBuffer::getMultiSample() const
 {
-    this->destroy();
+    return m_multi_sample;
 }
 
-void GLFrameBuffer::destroy()
+GLFrameBuffer& GLFrameBuffer::getResolveFrameBuffer() const
 {
-    if (m_fbo_id != 0)
+    const unsigned int color_attachment_num = this->getColorAttachmentNum();
+
+    if (m_fbo_id == 0 || m_multi_sample <= 1 || color_attachment_num == 0)
     {
-        glDeleteFramebuffers(1, &m_fbo_id);
-        m_fbo_id = 0;
+        LOGE("error: only color attachments of multi-sample fbo can be resolved");
+        throw std::runtime_error("error: only color attachments of multi-sample fbo can be resolved");
+    }
 
-        m_width = 0;
-        m_height = 0;
+    //NOTE: usually reached implicitly (getColorTex, getResolvedColorTex) while another fbo is bound for rendering,
+    //      so creating & resolving into the companion must not change the caller's bindings
+    GLFrameBufferBindingGuard binding_guard;
 
-        m_fbo_color_tex_vec.clear();
-        m_fbo_depth_tex.destroy();
-    }
-}
+    if (m_resolve_fbo == nullptr)
+    {
+        //same formats, single sample, no depth
+        std::vector<GLColorAttachmentDesc> color_attachments(color_attachment_num);
+        for (unsigned int i = 0; i < color_attachment_num; ++i)
+        {
+            color_attachments[i].internal_format = this->useRenderBuffer() ? m_color_render_buffers[i].getInternalFormat()
+                                                                           : m_fbo_color_tex_vec[i].getInternalFormat();
 
-void GLFrameBuffer::bind(bool set_viewport, bool clear_color_depth) const
-{
-    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id));
+            if (i < m_color_attachment_descs.size())
+                color_attachments[i].mip_levels = m_color_attachment_descs[i].mip_levels;
+        }
 
-    std::vector<GLuint> attachments;
-    for (unsigned int i = 0; i < m_fbo_color_tex_vec.size(); ++i)
-        attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+        m_resolve_fbo = std::make_unique<GLFrameBuffer>(m_capacity_width, m_capacity_height, color_attachments);
+        m_resolve_dirty = true;
+    }
 
-    glVerify(glDrawBuffers(attachments.size(), attachments.data()));
+    //follow logical size of resizable fbo, capacity is the same, i.e. no reallocation
+    if (m_resolve_fbo->getWidth() != m_width || m_resolve_fbo->getHeight() != m_height)
+        m_resolve_fbo->resize(m_width, m_height, true);
 
-    if (set_viewport)
-        glViewport(0, 0, m_width, m_height);
+    if (!m_resolve_dirty)
+        return *m_resolve_fbo;
 
-    if (clear_color_depth)
+    glVerify(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo_id));
+    glVerify(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_resolve_fbo->id()));
+
+    //NOTE: blit copies the read buffer into all draw buffers, i.e. one attachment at a time for MRT,
+    //      OpenGLES requires draw buffer i to be GL_COLOR_ATTACHMENTi or GL_NONE
+    std::vector<GLenum> draw_buffers(color_attachment_num, GL_NONE);
+    for (unsigned int i = 0; i < color_attachment_num; ++i)
     {
-        glClearDepthf(1.0);
-        glClearColor(0.0, 0.0, 0.0, 1.0);
+        glVerify(glReadBuffer(GL_COLOR_ATTACHMENT0 + i));
 
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        if (color_attachment_num > 1)
+        {
+            std::fill(draw_buffers.begin(), draw_buffers.end(), GL_NONE);
+            draw_buffers[i] = GL_COLOR_ATTACHMENT0 + i;
+            glVerify(glDrawBuffers(i + 1, draw_buffers.data()));
+        }
+
+        glVerify(glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
     }
-}
 
-void GLFrameBuffer::unbind() const
-{
-    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    glVerify(glReadBuffer(GL_COLOR_ATTACHMENT0));
 
-    //error: Invalid Operation, why ?
-    //GLuint attachments[] = {GL_COLOR_ATTACHMENT0};
-    //glVerify(glDrawBuffers(1, attachments));
-}
+    //restore draw buffers of the companion (fbo state)
+    if (color_attachment_num > 1)
+        m_resolve_fbo->bindDrawBuffers();
 
-GLuint GLFrameBuffer::id() const
-{
-    return m_fbo_id;
+    m_resolve_fbo->markContentsChanged();
+    m_resolve_dirty = false;
+
+    return *m_resolve_fbo;
 }
 
-GLTexture& GLFrameBuffer::getColorTex(int id)
+bool GLFrameBuffer::hasStencil() const
 {
-    return m_fbo_color_tex_vec[id];
+    return m_depth_stencil_format == GL_DEPTH24_STENCIL8 || m_depth_stencil_format == GL_DEPTH32F_STENCIL8;
 }
 
-const GLTexture & GLFrameBuffer::getColorTex(int id) const
+bool GLFrameBuffer::useRenderBuffer() const
 {
-    return m_fbo_color_tex_vec[id];
+    return !m_color_render_buffers.empty();
 }
 
-std::vector<GLTexture>& GLFrameBuffer::getColorTexVec()
+unsigned int GLFrameBuffer::getColorAttachmentNum() const
 {
-    return m_fbo_color_tex_vec;
+    const size_t layered_attachment_num = m_layered_tex_id != 0 ? 1 : 0;
+
+    return static_cast<unsigned int>(std::max({m_fbo_color_tex_vec.size(), m_color_render_buffers.size(), layered_attachment_num}));
 }
 
-const std::vector<GLTexture>& GLFrameBuffer::getColorTexVec() const
+bool GLFrameBuffer::hasDepth() const
 {
-    return m_fbo_color_tex_vec;
+    return m_fbo_depth_tex.isValid() || m_depth_render_buffer.isValid();
 }
 
 GLTexture& GLFrameBuffer::getDepthTex()
@@ -318,6 +1154,19 @@ bool GLFrameBuffer::readFrameBufferData(Scale* data, GLenum format, int data_siz
         return false;
     }
 
+    if (m_multi_sample > 1)
+    {
+        if (format == GL_DEPTH_COMPONENT)
+        {
+            LOGE("error: depth of multi-sample fbo can not be read");
+            throw std::invalid_argument("error: depth of multi-sample fbo can not be read");
+            return false;
+        }
+
+        //glReadPixels can not read multi-sample fbo, read the resolved companion
+        return this->resolve().readFrameBufferData(data, format, data_size_in_byte, color_attachment_id);
+    }
+
     if (data_size_in_byte >= 0)
     {
         const int channel_num = GLTexture::getChannelNum(format);
@@ -412,45 +1261,163 @@ bool GLFrameBuffer::read(cv::Mat& img, GLenum format, bool convert_to_bgr, bool
     }
 
 
-    img.create(m_height, m_width, type);
+    if (convert_to_bgr && format != GL_RGB && format != GL_RGBA)
+    {
+        LOGE("error: unsupported format to convert_to_bgr");
+        convert_to_bgr = false;
+    }
+
+    const bool is_color = (format != GL_DEPTH_COMPONENT);
+
+    bool succ = false;
+
+#if WIN32 || __MACOS__
+    //the driver swaps channels during transfer
+    GLenum read_format = format;
+    if (convert_to_bgr)
+        read_format = (format == GL_RGB) ? GL_BGR : GL_BGRA;
+
+    const bool use_swizzle_pass = false;
+#else
+    //NOTE: OpenGLES has no GL_BGR/GL_BGRA, swap on GPU by a copy pass before readback
+    GLenum read_format = format;
+
+    //the pass processes whole textures, i.e. the cpu swaps channels of the rendered sub-rectangle instead,
+    //a layered attachment has no GLTexture to sample, layer 0 is read by glReadPixels
+    const bool cpu_swap = this->hasSlack() || m_layered_tex_id != 0;
+
+    const bool use_swizzle_pass = convert_to_bgr && !cpu_swap;
+    if (convert_to_bgr && cpu_swap)
+        return this->readAsync(format, GL_UNSIGNED_BYTE, color_attachment_id).copyTo(img, PixelConversion::SWAP_RED_BLUE, vertical_flip);
+#endif
+
+    if (use_swizzle_pass)
+    {
+        GLSwizzlePass& swizzle_pass = GLContextResources::current().getSwizzlePass();
+
+        //flip is done by the pass as well
+        img.create(m_height, m_width, type);
+        succ = swizzle_pass.read(this->getResolvedColorTex(color_attachment_id), img.data, format, true, vertical_flip);
+    }
+    else if (vertical_flip && is_color)
+    {
+        //rows are reversed while copying out of the pack-PBO, i.e. no extra cv::flip pass
+        succ = this->readAsync(read_format, GL_UNSIGNED_BYTE, color_attachment_id).copyTo(img, true);
+    }
+    else
+    {
+        img.create(m_height, m_width, type);
+        succ = this->read(img.data, read_format, -1, color_attachment_id);
+
+        if (succ && vertical_flip)
+            cv::flip(img, img, 0);
+    }
 
-    bool succ = this->read(img.data, format, -1, color_attachment_id);
     if (!succ)
     {
         LOGE("error: can not read frame buffer");
         return false;
     }
 
-    if (convert_to_bgr)
+    return true;
+}
+
+GLAsyncReadback GLFrameBuffer::readAsync(GLenum format, GLenum type, int color_attachment_id) const
+{
+    if (m_fbo_id == 0)
     {
-        if (format == GL_RGB)
-            cv::cvtColor(img, img, CV_RGB2BGR);
-        else if (format == GL_RGBA)
-            cv::cvtColor(img, img, CV_RGBA2BGRA);
-        else
-            LOGE("error: unsupported format to convert_to_bgr");
+        LOGE("error: invalid fbo id: %d", m_fbo_id);
+        throw std::invalid_argument("error: invalid fbo id");
     }
 
-    if (vertical_flip)
-        cv::flip(img, img, 0);
+    if (m_multi_sample > 1)
+    {
+        if (format == GL_DEPTH_COMPONENT)
+        {
+            LOGE("error: depth of multi-sample fbo can not be read");
+            throw std::invalid_argument("error: depth of multi-sample fbo can not be read");
+        }
 
-    return true;
+        return this->resolve().readAsync(format, type, color_attachment_id);
+    }
+
+    GLAsyncReadback readback(m_width, m_height, format, type);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id);
+
+    readback.getPixelBuffer().bind();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, GLAsyncReadback::PACK_ALIGNMENT);
+
+    //data pointer is an offset into the bound GL_PIXEL_PACK_BUFFER, i.e. returns without waiting for GPU
+    if (readback.getFormat() == GL_DEPTH_COMPONENT)
+    {
+        glVerify(glReadPixels(0, 0, m_width, m_height, readback.getFormat(), type, nullptr));
+    }
+    else
+    {
+        glVerify(glReadBuffer(GL_COLOR_ATTACHMENT0 + color_attachment_id));
+        glVerify(glReadPixels(0, 0, m_width, m_height, readback.getFormat(), type, nullptr));
+        glVerify(glReadBuffer(GL_COLOR_ATTACHMENT0));
+    }
+
+    readback.getPixelBuffer().unbind();
+
+    readback.getFence().insert();
+
+    //make sure the fence is submitted, otherwise isReady() may never become true without a swap
+    glFlush();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return readback;
 }
 
-bool GLFrameBuffer::save(const std::string& image_file, bool vertical_flip, int color_attachment_id) const
+GLMappedImage GLFrameBuffer::readMapped(GLenum format, GLenum type, int color_attachment_id) const
 {
-    std::vector<unsigned char> data(3 * m_height * m_width);
+    return GLMappedImage(this->readAsync(format, type, color_attachment_id));
+}
+
+bool GLFrameBuffer::readYUV(cv::Mat& yuv,
+                            YUVFormat yuv_format,
+                            YUVColorSpace color_space,
+                            bool vertical_flip,
+                            int color_attachment_id) const
+{
+    if (this->hasSlack())
+    {
+        LOGE("error: readYUV packs whole textures, call resize(width, height, false) to drop the grow-only capacity first");
+        throw std::runtime_error("error: readYUV does not support grow-only capacity");
+        return false;
+    }
+
+    if (m_layered_tex_id != 0)
+    {
+        LOGE("error: readYUV packs a color texture, layered fbo has none, pack a single-layer fbo instead");
+        throw std::runtime_error("error: readYUV does not support layered fbo");
+        return false;
+    }
+
+    //packer is owned by the GLContextResources of the current context
+    GLYUVPacker& packer = GLContextResources::current().getYUVPacker();
+
+    packer.pack(this->getResolvedColorTex(color_attachment_id), yuv_format, color_space, vertical_flip);
 
-    bool succ = this->read(data.data(), GL_RGB, -1, color_attachment_id);
+    return packer.read(yuv);
+}
+
+bool GLFrameBuffer::save(const std::string& image_file, bool vertical_flip, int color_attachment_id) const
+{
+    //GL_RGBA is the readback format guaranteed by opengl es, alpha is dropped while flipping
+    cv::Mat rgb;
+    bool succ = this->readAsync(GL_RGBA, GL_UNSIGNED_BYTE, color_attachment_id).copyTo(rgb, PixelConversion::RGBA_TO_RGB, vertical_flip);
     if (!succ)
     {
         LOGE("error: can not read texture");
         return false;
     }
 
-    stbi_flip_vertically_on_write(vertical_flip);
-    stbi_write_png(image_file.c_str(), m_width, m_height, 3, data.data(), 3 * m_width);
-    stbi_flip_vertically_on_write(false);
+    stbi_write_png(image_file.c_str(), m_width, m_height, 3, rgb.data, static_cast<int>(rgb.step[0]));
 
     return true;
 }
@@ -7,14 +7,68 @@
 
 #pragma once
 
+#include <memory>
+
 #include "opencv2/opencv.hpp"
 
 #include "gl_include.h"
 
 #include "gl_texture.h"
+#include "gl_render_buffer.h"
+#include "gl_render_pass.h"
+#include "gl_async_readback.h"
+#include "gl_mapped_image.h"
+#include "gl_yuv_format.h"
 
 namespace luna{
 
+class GLTextureArray;
+class GLTextureCubeMap;
+
+//NOTE: multi-sample fbo is resolved into a lazily created single-sample companion fbo (glBlitFramebuffer)
+//      when it is read, saved or sampled (getResolvedColorTex), and only if it was bound for rendering since
+//      the last resolve. With use_render_buffer, color samples live in render buffers (cheaper than
+//      multi-sample textures, also available on ios), getColorTex() then returns the resolved texture.
+//      BGR readback (OpenGLES) and readYUV use the helper passes of GLContextResources::current().
+
+enum class GLAttachmentStorage
+{
+    TEXTURE,        //!< sampleable by later passes
+    RENDER_BUFFER,  //!< render only, tile-based GPUs may keep it in tile memory (with DISCARD store action)
+};
+
+struct GLDepthStencilDesc
+{
+    //GL_DEPTH_COMPONENT16/24/32F, GL_DEPTH24_STENCIL8 or GL_DEPTH32F_STENCIL8, 0 means no depth & stencil,
+    //GL_DEPTH_COMPONENT is the former unsized depth texture (u8 on android, float otherwise)
+    GLint internal_format = GL_DEPTH24_STENCIL8;
+
+    GLAttachmentStorage storage = GLAttachmentStorage::RENDER_BUFFER;
+
+    unsigned int multi_sample = 1; //must match color attachments
+
+    bool hasDepth() const
+    {
+        return internal_format != 0;
+    }
+
+    bool hasStencil() const
+    {
+        return internal_format == GL_DEPTH24_STENCIL8 || internal_format == GL_DEPTH32F_STENCIL8;
+    }
+};
+
+struct GLColorAttachmentDesc
+{
+    //any color-renderable sized format, e.g. GL_RGBA8 albedo, GL_RG16F normal, GL_R32F depth-like data
+    GLint internal_format = GL_RGBA8;
+
+    unsigned int multi_sample = 1; //must be the same for all attachments of a fbo
+
+    //<= 0 means full mip chain, levels 1..n-1 are generated when the texture is sampled after rendering (single-sample only)
+    int mip_levels = 1;
+};
+
 class GLFrameBuffer
 {
 public:
@@ -25,21 +79,99 @@ public:
                   int height,
                   bool need_depth = false,
                   bool need_color = true,
-                  bool use_float_color = false,
+                  bool use_float_color = false,           //GL_RGBA32F (GL_RGBA16F on ios), GL_RGBA8 otherwise
                   unsigned int multi_sample = 1,
-                  unsigned int color_attachment_num = 1); //color_attachment_num is only used when need_color is true
+                  unsigned int color_attachment_num = 1,  //color_attachment_num is only used when need_color is true
+                  bool use_render_buffer = false);        //multi-sample attachments are render buffers, see below
 
     bool init(int width,
               int height,
               bool need_depth = false,
               bool need_color = true,
-              bool use_float_color = false,
+              bool use_float_color = false,           //GL_RGBA32F (GL_RGBA16F on ios), GL_RGBA8 otherwise
               unsigned int multi_sample = 1,
-              unsigned int color_attachment_num = 1); //color_attachment_num is only used when need_color is true
+              unsigned int color_attachment_num = 1,  //color_attachment_num is only used when need_color is true
+              bool use_render_buffer = false);        //multi-sample attachments are render buffers, see below
 
-    bool init(const GLTexture& color_tex);
+    //explicit color format, e.g. GL_RGBA16F/GL_RGB10_A2 for a reduced-bandwidth target
+    GLFrameBuffer(int width,
+                  int height,
+                  bool need_depth,
+                  bool need_color,
+                  GLint color_internal_format,
+                  unsigned int multi_sample = 1,
+                  unsigned int color_attachment_num = 1,
+                  bool use_render_buffer = false);
+
+    bool init(int width,
+              int height,
+              bool need_depth,
+              bool need_color,
+              GLint color_internal_format,
+              unsigned int multi_sample = 1,
+              unsigned int color_attachment_num = 1,
+              bool use_render_buffer = false);
+
+    //color_attachment_num == 0 means depth/stencil only
+    GLFrameBuffer(int width,
+                  int height,
+                  const GLDepthStencilDesc& depth_stencil,
+                  GLint color_internal_format = GL_RGBA8,
+                  unsigned int multi_sample = 1,
+                  unsigned int color_attachment_num = 1,
+                  bool use_render_buffer = false);        //multi-sample color attachments are render buffers
+
+    bool init(int width,
+              int height,
+              const GLDepthStencilDesc& depth_stencil,
+              GLint color_internal_format = GL_RGBA8,
+              unsigned int multi_sample = 1,
+              unsigned int color_attachment_num = 1,
+              bool use_render_buffer = false);        //multi-sample color attachments are render buffers
+
+    //attachment i gets its own format, i.e. a MRT pass writes exactly the bytes it needs,
+    //color_attachments may be empty (depth/stencil only)
+    GLFrameBuffer(int width,
+                  int height,
+                  const std::vector<GLColorAttachmentDesc>& color_attachments,
+                  const GLDepthStencilDesc& depth_stencil = GLDepthStencilDesc{0},
+                  bool use_render_buffer = false);    //multi-sample color attachments are render buffers
+
+    bool init(int width,
+              int height,
+              const std::vector<GLColorAttachmentDesc>& color_attachments,
+              const GLDepthStencilDesc& depth_stencil = GLDepthStencilDesc{0},
+              bool use_render_buffer = false);    //multi-sample color attachments are render buffers
 
-    bool init(GLuint color_tex_id, int width, int height);
+    //render into mip_level of color_tex, e.g. a downsample chain or user-written levels (MipmapFilter::NONE)
+    //NOTE: the wrapped texture can not be told about rendering into its level 0,
+    //      call color_tex.markContentsChanged() afterwards if its levels are generated
+    bool init(const GLTexture& color_tex, int mip_level = 0);
+
+    bool init(GLuint color_tex_id, int width, int height, int mip_level = 0); //width/height of the attached level
+
+    //wrap external textures as color attachments 0..n-1 (MRT), textures must have the same size and outlive the fbo
+    bool init(const std::vector<const GLTexture*>& color_texs);
+
+    //layered color attachment of all layers (faces), i.e. one draw renders every layer selected by gl_Layer,
+    //see GLLayeredPass, the texture must outlive the fbo, reads (read/save/readAsync) read layer 0 (or the attached layer),
+    //there is no color GLTexture, i.e. getColorTex() & readYUV() throw
+    //NOTE: gl_Layer is written by a geometry shader, which is desktop only in GLShader,
+    //      on OpenGLES layer 0 is attached instead and layers are rendered one by one via attachLayer()
+    bool init(const GLTextureArray& tex_array);
+
+    bool init(const GLTextureCubeMap& cubemap); //layer i is face GL_TEXTURE_CUBE_MAP_POSITIVE_X + i
+
+    //attach a single layer (face) of the layered texture, -1 attaches all layers again, leaves the fbo bound,
+    //inside a render pass the color store action is applied to the previous layer and the load action to the new one
+    bool attachLayer(int layer);
+
+    int getLayerNum() const; //0 if no layered texture is attached
+
+    int getAttachedLayer() const; //-1 if all layers are attached
+
+    //layered attachment (all layers at once) is supported by this build
+    static bool isLayeredRenderingSupported();
 
     ~GLFrameBuffer();
 
@@ -55,10 +187,31 @@ public:
 
     //-----------
 
+    //change logical size, viewport & readback follow it,
+    //grow_only: keep the allocation if it is large enough and render into its bottom-left sub-rectangle,
+    //           sample color textures with v_tex_coord * getTexCoordScale() then,
+    //           otherwise (or growing beyond capacity) attachments are reallocated, i.e. texture ids change
+    //NOTE: only fbo created from attachment descriptors (not wrapping external textures) can be resized
+    bool resize(int width, int height, bool grow_only = true);
+
+    //allocated size of attachments, >= getWidth()/getHeight()
+    int getCapacityWidth() const;
+
+    int getCapacityHeight() const;
+
+    //logical size / capacity, i.e. tex coord scale for sampling the rendered sub-rectangle of color textures
+    glm::vec2 getTexCoordScale() const;
+
     void bind(bool set_viewport = true, bool clear_color_depth = true) const;
 
     void unbind() const;
 
+    //bind & apply load actions, i.e. clear or invalidate attachments before rendering
+    void beginRenderPass(const GLRenderPass& render_pass, bool set_viewport = true);
+
+    //apply store actions, i.e. invalidate discarded attachments after rendering, then unbind
+    void endRenderPass();
+
     GLuint id() const;
 
     GLTexture& getColorTex(int id = 0);
@@ -69,6 +222,21 @@ public:
 
     const std::vector<GLTexture>& getColorTexVec() const;
 
+    //single-sample color texture, multi-sample contents are resolved first if changed
+    const GLTexture& getResolvedColorTex(int id = 0) const;
+
+    //resolve into the single-sample companion if contents changed, returns *this for single-sample fbo
+    const GLFrameBuffer& resolve() const;
+
+    //contents are changed without bind()/beginRenderPass(), e.g. rendered through id(), resolve again on next read,
+    //mip levels of owned color textures are generated again on next sampling
+    void markContentsChanged() const;
+
+    unsigned int getMultiSample() const;
+
+    bool hasStencil() const;
+
+    //invalid texture if depth is a render buffer
     GLTexture& getDepthTex();
 
     const GLTexture& getDepthTex() const;
@@ -97,11 +265,52 @@ public:
               bool vertical_flip = true,
               int color_attachment_id = 0) const;
 
+    //start readback into a pooled pack-PBO and return immediately, result is available a few frames later
+    //NOTE: GL_RGBA & GL_UNSIGNED_BYTE is the only combination guaranteed by opengl es
+    GLAsyncReadback readAsync(GLenum format = GL_RGBA,
+                              GLenum type = GL_UNSIGNED_BYTE,
+                              int color_attachment_id = 0) const;
+
+    //read into a pack-PBO and map it, zero-copy alternative of read(cv::Mat&), rows are bottom-up
+    GLMappedImage readMapped(GLenum format = GL_RGBA,
+                             GLenum type = GL_UNSIGNED_BYTE,
+                             int color_attachment_id = 0) const;
+
+    //pack color attachment into I420/NV12/NV21 on GPU, then read back 1.5 bytes per pixel
+    //yuv: CV_8UC1, (height * 3 / 2) x width, rows top-down if vertical_flip, directly consumable by video encoders
+    //NOTE: width % 4 == 0 and height % 2 == 0 are required, see GLYUVPacker
+    bool readYUV(cv::Mat& yuv,
+                 YUVFormat yuv_format = YUVFormat::I420,
+                 YUVColorSpace color_space = YUVColorSpace::BT601_LIMITED,
+                 bool vertical_flip = true,
+                 int color_attachment_id = 0) const;
+
 private:
 
     template <typename Scale>
     bool readFrameBufferData(Scale* data, GLenum format, int data_size_in_byte, int color_attachment_id = 0) const;
 
+    void bindDrawBuffers() const;
+
+    static void invalidateAttachments(const std::vector<GLenum>& attachments);
+
+    GLFrameBuffer& getResolveFrameBuffer() const;
+
+    bool useRenderBuffer() const;
+
+    unsigned int getColorAttachmentNum() const;
+
+    bool hasDepth() const;
+
+    bool hasSlack() const;
+
+    //throw if there is no color GLTexture of attachment id, e.g. layered fbo
+    void checkColorTex(int id) const;
+
+    bool initLayered(GLenum target, GLuint tex_id, int width, int height, int layer_num);
+
+    static constexpr int RESIZE_GRANULARITY = 64;
+
 private:
     GLuint m_fbo_id = 0;
 
@@ -109,8 +318,39 @@ private:
 
     GLTexture m_fbo_depth_tex;
 
+    //multi-sample storage if use_render_buffer
+    std::vector<GLRenderBuffer> m_color_render_buffers;
+    GLRenderBuffer m_depth_render_buffer;
+
+    unsigned int m_multi_sample = 1;
+
+    GLint m_depth_stencil_format = 0;
+
+    //single-sample companion of multi-sample fbo, created on first resolve
+    mutable std::unique_ptr<GLFrameBuffer> m_resolve_fbo;
+    mutable bool m_resolve_dirty = true;
+
     int m_width = 0;
     int m_height = 0;
+
+    //allocated size, larger than m_width/m_height after grow-only resize
+    int m_capacity_width = 0;
+    int m_capacity_height = 0;
+
+    //descriptors of owned attachments, kept for resize()
+    std::vector<GLColorAttachmentDesc> m_color_attachment_descs;
+    GLDepthStencilDesc m_depth_stencil_desc = GLDepthStencilDesc{0};
+    bool m_use_render_buffer = false;
+    bool m_resizable = false;
+
+    //external GL_TEXTURE_2D_ARRAY or GL_TEXTURE_CUBE_MAP attached as color attachment 0
+    GLuint m_layered_tex_id = 0;
+    GLenum m_layered_target = 0;
+    int m_layer_num = 0;
+    int m_attached_layer = -1;
+
+    GLRenderPass m_render_pass;
+    bool m_in_render_pass = false;
 };
 
 using GLFBO = GLFrameBuffer;
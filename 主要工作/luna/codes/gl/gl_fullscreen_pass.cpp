@@ -0,0 +1,51 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: full screen pass, draw a single triangle covering the viewport
+ * @version    : 1.0
+ */
+
+#include "gl_utility.h"
+
+#include "gl_shader.h"
+
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+static const char* FULLSCREEN_VERTEX_SHADER = R"(
+uniform bool u_flip_tex_coord; //src rows are stored upside down, i.e. FLIP_TEXCOORD texture
+
+out vec2 v_tex_coord;
+
+void main()
+{
+    //(0, 0), (2, 0), (0, 2), i.e. a triangle covering [0, 1] x [0, 1]
+    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+
+    v_tex_coord = u_flip_tex_coord ? vec2(pos.x, 1.0 - pos.y) : pos;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+void GLFullScreenPass::draw() const
+{
+    if (!m_vao)
+        m_vao = std::make_unique<GLVertexAttribArray>();
+
+    m_vao->bind();
+    glVerify(glDrawArrays(GL_TRIANGLES, 0, 3));
+    m_vao->unbind();
+}
+
+void GLFullScreenPass::setTexCoordFlip(GLShader& shader, bool flip)
+{
+    shader.setBool("u_flip_tex_coord", flip);
+}
+
+const char* GLFullScreenPass::getVertexShaderSource()
+{
+    return FULLSCREEN_VERTEX_SHADER;
+}
+
+}//end of namespace luna
@@ -0,0 +1,54 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: full screen pass, draw a single triangle covering the viewport
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "gl_include.h"
+
+#include "gl_vertex_attrib_array.h"
+
+namespace luna {
+
+//NOTE: vertex positions are generated from gl_VertexID, i.e. no vertex buffer is needed,
+//      an empty VAO is still required by core profile.
+//      vertex shader outputs "v_tex_coord" in [0, 1], bottom-left is (0, 0).
+//      "v_tex_coord" is flipped vertically by setTexCoordFlip (uniform "u_flip_tex_coord", false by default),
+//      i.e. a FLIP_TEXCOORD source (GLTexture::isVerticalFlipped) is sampled upright.
+
+class GLShader;
+
+class GLFullScreenPass
+{
+public:
+
+    GLFullScreenPass() = default;
+
+    ~GLFullScreenPass() = default;
+
+    //disable copy
+    GLFullScreenPass(const GLFullScreenPass& rhs) = delete;
+    GLFullScreenPass& operator = (const GLFullScreenPass& rhs) = delete;
+
+    //enable move
+    GLFullScreenPass(GLFullScreenPass&& rhs) noexcept = default;
+    GLFullScreenPass& operator = (GLFullScreenPass&& rhs) noexcept = default;
+
+    //draw with current bound shader & framebuffer, VAO is created lazily on first draw
+    void draw() const;
+
+    //shader must be in use, e.g. setTexCoordFlip(shader, src.isVerticalFlipped())
+    static void setTexCoordFlip(GLShader& shader, bool flip);
+
+    static const char* getVertexShaderSource();
+
+private:
+    mutable std::unique_ptr<GLVertexAttribArray> m_vao;
+};
+
+}//end of namespace luna
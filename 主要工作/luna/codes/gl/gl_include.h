@@ -25,3 +25,13 @@
         #error "Unknown Apple platform"
     #endif
 #endif
+
+//NOTE: OpenGLES has no GL_BGR/GL_BGRA, they are defined as client-side format tags only,
+//      i.e. never passed to gl, GLTexture uploads as GL_RGB/GL_RGBA and swaps channels by texture swizzle
+#ifndef GL_BGR
+    #define GL_BGR 0x80E0
+#endif
+
+#ifndef GL_BGRA
+    #define GL_BGRA 0x80E1
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: layered full screen pass, fill every layer of a texture array / every face of a cubemap by one draw
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_shader.h"
+#include "gl_framebuffer.h"
+
+#include "gl_layered_pass.h"
+
+namespace luna {
+
+//u_layer is the first layer, i.e. 0 for the instanced draw, the attached layer for per-layer draws
+static const char* LAYERED_VERTEX_SHADER = R"(
+uniform int u_layer;
+
+out vec2 v_tex_coord_vs;
+flat out int v_layer_vs;
+
+out vec2 v_tex_coord;
+flat out int v_layer;
+
+void main()
+{
+    //(0, 0), (2, 0), (0, 2), i.e. a triangle covering [0, 1] x [0, 1]
+    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+
+    v_tex_coord_vs = pos;
+    v_layer_vs = u_layer + gl_InstanceID;
+
+    //used directly by fragment shader if there is no geometry shader
+    v_tex_coord = pos;
+    v_layer = v_layer_vs;
+
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+static const char* LAYERED_GEOMETRY_SHADER = R"(
+layout(triangles) in;
+layout(triangle_strip, max_vertices = 3) out;
+
+in vec2 v_tex_coord_vs[];
+flat in int v_layer_vs[];
+
+out vec2 v_tex_coord;
+flat out int v_layer;
+
+void main()
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        gl_Layer = v_layer_vs[0];
+
+        v_tex_coord = v_tex_coord_vs[i];
+        v_layer = v_layer_vs[0];
+
+        gl_Position = gl_in[i].gl_Position;
+        EmitVertex();
+    }
+
+    EndPrimitive();
+}
+)";
+
+//same face orientation as cubemap sampling, i.e. rendering cubeMapDirection(face, uv) into face reproduces the environment
+static const char* CUBEMAP_DIRECTION_FUNCTION = R"(
+vec3 cubeMapDirection(int face, vec2 uv)
+{
+    vec2 st = uv * 2.0 - 1.0;
+
+    vec3 dir;
+    if (face == 0)      dir = vec3( 1.0, -st.y, -st.x);
+    else if (face == 1) dir = vec3(-1.0, -st.y,  st.x);
+    else if (face == 2) dir = vec3( st.x,  1.0,  st.y);
+    else if (face == 3) dir = vec3( st.x, -1.0, -st.y);
+    else if (face == 4) dir = vec3( st.x, -st.y,  1.0);
+    else                dir = vec3(-st.x, -st.y, -1.0);
+
+    return normalize(dir);
+}
+)";
+
+void GLLayeredPass::draw(GLFrameBuffer& fbo, GLShader& shader) const
+{
+    const int layer_num = fbo.getLayerNum();
+    if (layer_num <= 0)
+    {
+        LOGE("error: no layered texture is attached to fbo");
+        throw std::invalid_argument("error: no layered texture is attached to fbo");
+    }
+
+    if (!m_vao)
+        m_vao = std::make_unique<GLVertexAttribArray>();
+
+    m_vao->bind();
+
+    if (fbo.getAttachedLayer() == -1)
+    {
+        //all layers attached, instance i is routed to gl_Layer i
+        shader.setInt("u_layer", 0);
+        glVerify(glDrawArraysInstanced(GL_TRIANGLES, 0, 3, layer_num));
+    }
+    else
+    {
+        for (int layer = 0; layer < layer_num; ++layer)
+        {
+            fbo.attachLayer(layer);
+
+            shader.setInt("u_layer", layer);
+            glVerify(glDrawArrays(GL_TRIANGLES, 0, 3));
+        }
+    }
+
+    m_vao->unbind();
+}
+
+const char* GLLayeredPass::getVertexShaderSource()
+{
+    return LAYERED_VERTEX_SHADER;
+}
+
+const char* GLLayeredPass::getGeometryShaderSource()
+{
+    return GLFrameBuffer::isLayeredRenderingSupported() ? LAYERED_GEOMETRY_SHADER : "";
+}
+
+const char* GLLayeredPass::getCubeMapDirectionSource()
+{
+    return CUBEMAP_DIRECTION_FUNCTION;
+}
+
+}//end of namespace luna
@@ -0,0 +1,60 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: layered full screen pass, fill every layer of a texture array / every face of a cubemap by one draw
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "gl_include.h"
+
+#include "gl_vertex_attrib_array.h"
+
+namespace luna {
+
+class GLShader;
+class GLFrameBuffer;
+
+//NOTE: shader = vertex + fragment + geometry source of this class, fragment shader reads
+//      "in vec2 v_tex_coord" (same as GLFullScreenPass) and "flat in int v_layer" (layer / cubemap face).
+//      With all layers attached (GLFrameBuffer::init(GLTextureArray/GLTextureCubeMap) on desktop),
+//      one instanced draw renders layer_num instances and the geometry shader routes instance i to
+//      gl_Layer i. Otherwise (OpenGLES, or a single layer attached) layers are attached & drawn one by one,
+//      i.e. one fbo & one shader bind instead of one fbo per layer.
+
+class GLLayeredPass
+{
+public:
+
+    GLLayeredPass() = default;
+
+    ~GLLayeredPass() = default;
+
+    //disable copy
+    GLLayeredPass(const GLLayeredPass& rhs) = delete;
+    GLLayeredPass& operator = (const GLLayeredPass& rhs) = delete;
+
+    //enable move
+    GLLayeredPass(GLLayeredPass&& rhs) noexcept = default;
+    GLLayeredPass& operator = (GLLayeredPass&& rhs) noexcept = default;
+
+    //draw every layer of fbo with the bound shader, call inside fbo.beginRenderPass()/endRenderPass()
+    void draw(GLFrameBuffer& fbo, GLShader& shader) const;
+
+    static const char* getVertexShaderSource();
+
+    //empty if layered rendering is not supported, see GLFrameBuffer::isLayeredRenderingSupported()
+    static const char* getGeometryShaderSource();
+
+    //GLSL function "vec3 cubeMapDirection(int face, vec2 uv)", i.e. sampling direction of texel uv of a face,
+    //prepend it to fragment shaders rendering environment maps
+    static const char* getCubeMapDirectionSource();
+
+private:
+    mutable std::unique_ptr<GLVertexAttribArray> m_vao;
+};
+
+}//end of namespace luna
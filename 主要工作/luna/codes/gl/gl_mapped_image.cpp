@@ -0,0 +1,99 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: zero-copy cv::Mat view over mapped pixel buffer
+ * @version    : 1.0
+ */
+
+#include "core/log/log.h"
+
+#include "gl_mapped_image.h"
+
+namespace luna {
+
+GLMappedImage::GLMappedImage(GLAsyncReadback&& readback, bool bottom_up)
+    :m_readback(std::move(readback)), m_bottom_up(bottom_up)
+{
+    if (!m_readback.isValid())
+    {
+        LOGE("error: invalid readback handle");
+        throw std::invalid_argument("error: invalid readback handle");
+    }
+
+    m_mat = m_readback.map();
+}
+
+GLMappedImage::~GLMappedImage()
+{
+    this->release();
+}
+
+void GLMappedImage::release()
+{
+    //drop header first, then unmap
+    m_mat = cv::Mat();
+    m_readback.destroy();
+}
+
+GLMappedImage::GLMappedImage(GLMappedImage&& rhs) noexcept
+{
+    m_readback = std::move(rhs.m_readback);
+    m_mat = rhs.m_mat;
+    m_bottom_up = rhs.m_bottom_up;
+
+    rhs.m_mat = cv::Mat();
+    rhs.m_bottom_up = true;
+}
+
+GLMappedImage& GLMappedImage::operator = (GLMappedImage&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->release();
+
+        m_readback = std::move(rhs.m_readback);
+        m_mat = rhs.m_mat;
+        m_bottom_up = rhs.m_bottom_up;
+
+        rhs.m_mat = cv::Mat();
+        rhs.m_bottom_up = true;
+    }
+    return *this;
+}
+
+const cv::Mat& GLMappedImage::mat() const
+{
+    return m_mat;
+}
+
+GLMappedImage::operator const cv::Mat& () const
+{
+    return m_mat;
+}
+
+bool GLMappedImage::empty() const
+{
+    return m_mat.empty();
+}
+
+int GLMappedImage::getWidth() const
+{
+    return m_mat.cols;
+}
+
+int GLMappedImage::getHeight() const
+{
+    return m_mat.rows;
+}
+
+size_t GLMappedImage::getStep() const
+{
+    return m_mat.step[0];
+}
+
+bool GLMappedImage::isBottomUp() const
+{
+    return m_bottom_up;
+}
+
+}//end of namespace luna
@@ -0,0 +1,70 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: zero-copy cv::Mat view over mapped pixel buffer
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_async_readback.h"
+
+namespace luna {
+
+//NOTE: RAII view of readback result, the cv::Mat header points directly into the mapped PBO memory,
+//      i.e. no copy, no cvtColor, no flip. PBO is unmapped (and recycled) on destruction,
+//      so do not keep the cv::Mat header longer than the GLMappedImage.
+//      rows are usually bottom-up (opengl convention), but top-down for a vertically flipped source
+//      (FlipPolicy::FLIP_TEXCOORD), i.e. use isBottomUp() to handle orientation downstream.
+
+class GLMappedImage
+{
+public:
+
+    GLMappedImage() = default;
+
+    //take over a pending readback and map it, blocks if GPU has not finished yet,
+    //bottom_up: row order of the source, false for GLTexture::isVerticalFlipped()
+    explicit GLMappedImage(GLAsyncReadback&& readback, bool bottom_up = true);
+
+    ~GLMappedImage();
+
+    void release();
+
+    //disable copy
+    GLMappedImage(const GLMappedImage& rhs) = delete;
+    GLMappedImage& operator = (const GLMappedImage& rhs) = delete;
+
+    //enable move
+    GLMappedImage(GLMappedImage&& rhs) noexcept;
+    GLMappedImage& operator = (GLMappedImage&& rhs) noexcept;
+
+    //-----------
+
+    const cv::Mat& mat() const;
+
+    operator const cv::Mat& () const;
+
+    bool empty() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    size_t getStep() const;
+
+    bool isBottomUp() const;
+
+private:
+    GLAsyncReadback m_readback;
+
+    cv::Mat m_mat;
+
+    bool m_bottom_up = true;
+};
+
+using MappedImage = GLMappedImage;
+
+}//end of namespace luna
@@ -0,0 +1,213 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: generate mip levels of a texture by glGenerateMipmap or a box/gaussian downsample pass
+ * @version    : 1.0
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+
+#include "gl_mip_generator.h"
+
+namespace luna {
+
+static const char* MIP_DOWNSAMPLE_FRAGMENT_SHADER = R"(
+precision highp float;
+
+uniform sampler2D u_tex_src; //only the source level is in the sampled range, i.e. it is level 0 here
+uniform bool u_gaussian;
+uniform bool u_swap_red_blue;
+
+out vec4 frag_color;
+
+vec4 fetch(ivec2 p, ivec2 max_p)
+{
+    return texelFetch(u_tex_src, clamp(p, ivec2(0), max_p), 0);
+}
+
+void main()
+{
+    ivec2 max_p = textureSize(u_tex_src, 0) - 1;
+    ivec2 p = ivec2(gl_FragCoord.xy) * 2;
+
+    vec4 color = vec4(0.0);
+
+    if (u_gaussian)
+    {
+        //separable binomial [1 3 3 1] / 8 around the 2x2 footprint
+        const float w[4] = float[4](1.0, 3.0, 3.0, 1.0);
+
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+                color += w[x] * w[y] * fetch(p + ivec2(x - 1, y - 1), max_p);
+        }
+
+        color /= 64.0;
+    }
+    else
+    {
+        color = 0.25 * (fetch(p, max_p) + fetch(p + ivec2(1, 0), max_p) +
+                        fetch(p + ivec2(0, 1), max_p) + fetch(p + ivec2(1, 1), max_p));
+    }
+
+    //texture swizzle of BGR storage is applied on fetch, write storage order back
+    frag_color = u_swap_red_blue ? color.bgra : color;
+}
+)";
+
+GLMipGenerator::~GLMipGenerator()
+{
+    this->destroy();
+}
+
+void GLMipGenerator::destroy()
+{
+    if (m_fbo_id != 0)
+    {
+        glDeleteFramebuffers(1, &m_fbo_id);
+        m_fbo_id = 0;
+    }
+
+    m_shader.destroy();
+}
+
+GLMipGenerator::GLMipGenerator(GLMipGenerator&& rhs) noexcept
+{
+    m_fbo_id = rhs.m_fbo_id;
+    m_shader = std::move(rhs.m_shader);
+    m_fullscreen_pass = std::move(rhs.m_fullscreen_pass);
+
+    rhs.m_fbo_id = 0;
+}
+
+GLMipGenerator& GLMipGenerator::operator = (GLMipGenerator&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_fbo_id = rhs.m_fbo_id;
+    m_shader = std::move(rhs.m_shader);
+    m_fullscreen_pass = std::move(rhs.m_fullscreen_pass);
+
+    rhs.m_fbo_id = 0;
+
+    return *this;
+}
+
+bool GLMipGenerator::generate(const GLTexture& tex, MipmapFilter filter)
+{
+    if (!tex.isValid() || tex.getMultiSample() > 1)
+    {
+        LOGE("error: invalid texture to generate mip levels");
+        throw std::invalid_argument("error: invalid texture to generate mip levels");
+        return false;
+    }
+
+    const int mip_levels = tex.getMipLevels();
+    if (mip_levels <= 1 || filter == MipmapFilter::NONE)
+        return true;
+
+    //NOTE: usually called lazily by GLShader::setTexture, i.e. in the middle of another pass,
+    //      so every binding & state touched here is restored afterwards
+    GLint pre_active_tex = GL_TEXTURE0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &pre_active_tex);
+
+    if (filter == MipmapFilter::HARDWARE)
+    {
+        GLint pre_tex_id = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &pre_tex_id);
+
+        tex.bind();
+        glVerify(glGenerateMipmap(GL_TEXTURE_2D));
+
+        glBindTexture(GL_TEXTURE_2D, pre_tex_id);
+
+        return true;
+    }
+
+    if (!m_shader.isValid())
+        m_shader.createFromString(GLFullScreenPass::getVertexShaderSource(), MIP_DOWNSAMPLE_FRAGMENT_SHADER);
+
+    if (m_fbo_id == 0)
+        glVerify(glGenFramebuffers(1, &m_fbo_id));
+
+    GLint pre_program = 0;
+    GLint pre_fbo_id = 0;
+    GLint pre_viewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_CURRENT_PROGRAM, &pre_program);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &pre_fbo_id);
+    glGetIntegerv(GL_VIEWPORT, pre_viewport);
+
+    glActiveTexture(GL_TEXTURE0);
+    GLint pre_tex_id = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &pre_tex_id);
+
+    //each level is overwritten, not blended
+    const GLboolean pre_blend = glIsEnabled(GL_BLEND);
+    const GLboolean pre_depth_test = glIsEnabled(GL_DEPTH_TEST);
+    const GLboolean pre_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_SCISSOR_TEST);
+
+    //NOTE: draw buffer of a new fbo defaults to GL_COLOR_ATTACHMENT0, i.e. no glDrawBuffers
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_id));
+
+    //bound manually, GLShader::setTexture would regenerate mip levels of tex, i.e. recurse
+    m_shader.use();
+    m_shader.setInt("u_tex_src", 0);
+    m_shader.setBool("u_gaussian", filter == MipmapFilter::GAUSSIAN);
+    m_shader.setBool("u_swap_red_blue", tex.isBGRStorage());
+
+    for (int level = 1; level < mip_levels; ++level)
+    {
+        tex.setLevelRange(level - 1, level - 1);
+
+        glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex.id(), level));
+
+#if __MACOS__
+        //NOTE: glInvalidateFramebuffer is not available on macOS (OpenGL 4.1), see GLFrameBuffer
+#else
+        //every texel of the level is overwritten
+        const GLenum attachment = GL_COLOR_ATTACHMENT0;
+        glVerify(glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &attachment));
+#endif
+
+        glVerify(glViewport(0, 0, tex.getLevelWidth(level), tex.getLevelHeight(level)));
+
+        tex.bind();
+        m_fullscreen_pass.draw();
+    }
+
+    tex.setLevelRange(0, mip_levels - 1);
+
+    //detach, i.e. the cached fbo never keeps a deleted texture alive
+    glVerify(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0));
+
+    //restore
+    if (pre_blend)
+        glEnable(GL_BLEND);
+    if (pre_depth_test)
+        glEnable(GL_DEPTH_TEST);
+    if (pre_scissor_test)
+        glEnable(GL_SCISSOR_TEST);
+
+    glBindTexture(GL_TEXTURE_2D, pre_tex_id);
+    glActiveTexture(pre_active_tex);
+
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, pre_fbo_id));
+    glViewport(pre_viewport[0], pre_viewport[1], pre_viewport[2], pre_viewport[3]);
+    glUseProgram(pre_program);
+
+    return true;
+}
+
+}//end of namespace luna
@@ -0,0 +1,53 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: generate mip levels of a texture by glGenerateMipmap or a box/gaussian downsample pass
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "gl_include.h"
+
+#include "gl_texture.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+//NOTE: level i is rendered from level i - 1 through a cached fbo, the sampled range of the texture is
+//      restricted to level i - 1 meanwhile (GL_TEXTURE_BASE_LEVEL/MAX_LEVEL), i.e. no feedback loop.
+//      Texels are fetched explicitly (texelFetch), so the result does not depend on the filter of the texture.
+
+class GLMipGenerator
+{
+public:
+
+    GLMipGenerator() = default;
+
+    ~GLMipGenerator();
+
+    void destroy();
+
+    //disable copy
+    GLMipGenerator(const GLMipGenerator& rhs) = delete;
+    GLMipGenerator& operator = (const GLMipGenerator& rhs) = delete;
+
+    //enable move
+    GLMipGenerator(GLMipGenerator&& rhs) noexcept;
+    GLMipGenerator& operator = (GLMipGenerator&& rhs) noexcept;
+
+    //-----------
+
+    //write levels 1 .. getMipLevels() - 1 of tex from level 0
+    //NOTE: HARDWARE needs a color-renderable & filterable format (e.g. not GL_RGBA32F on OpenGLES)
+    bool generate(const GLTexture& tex, MipmapFilter filter);
+
+private:
+    GLuint m_fbo_id = 0;
+
+    GLShader m_shader;
+    GLFullScreenPass m_fullscreen_pass;
+};
+
+}//end of namespace luna
@@ -0,0 +1,149 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: ping-pong frame buffer pair for iterative filters (diffusion, repeated blur, jacobi ...)
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_render_pass.h"
+
+#include "gl_ping_pong.h"
+
+namespace luna {
+
+GLPingPong::GLPingPong(int width, int height, GLint internal_format)
+{
+    bool succ = this->init(width, height, internal_format);
+    if (!succ)
+    {
+        LOGE("error: can not init GLPingPong");
+        throw std::invalid_argument("error: can not init GLPingPong");
+    }
+}
+
+bool GLPingPong::init(int width, int height, GLint internal_format)
+{
+    if (width <= 0 || height <= 0)
+    {
+        LOGE("error: invalid size of ping-pong targets: %d x %d", width, height);
+        throw std::invalid_argument("error: invalid size of ping-pong targets");
+        return false;
+    }
+
+    for (GLFrameBuffer& fbo : m_fbos)
+        fbo.init(width, height, false, true, internal_format);
+
+    m_src_index = 0;
+
+    return true;
+}
+
+void GLPingPong::destroy()
+{
+    for (GLFrameBuffer& fbo : m_fbos)
+        fbo.destroy();
+
+    m_src_index = 0;
+}
+
+GLTexture& GLPingPong::src()
+{
+    return m_fbos[m_src_index].getColorTex();
+}
+
+const GLTexture& GLPingPong::src() const
+{
+    return m_fbos[m_src_index].getColorTex();
+}
+
+GLFrameBuffer& GLPingPong::dst()
+{
+    return m_fbos[1 - m_src_index];
+}
+
+void GLPingPong::swap()
+{
+    m_src_index = 1 - m_src_index;
+}
+
+void GLPingPong::clear(const glm::vec4& color)
+{
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::CLEAR;
+    render_pass.default_color_action.clear_color = color;
+
+    for (GLFrameBuffer& fbo : m_fbos)
+    {
+        fbo.beginRenderPass(render_pass);
+        fbo.endRenderPass();
+    }
+}
+
+void GLPingPong::iterate(GLShader& shader,
+                         int iteration_num,
+                         const std::string& src_sampler_name,
+                         std::function<void(GLShader&, int)> per_iteration)
+{
+    if (!this->isValid())
+    {
+        LOGE("error: ping-pong targets are not initialized");
+        throw std::runtime_error("error: ping-pong targets are not initialized");
+    }
+
+    if (iteration_num <= 0)
+        return;
+
+    //both targets have the same size, draw buffers are fbo state set in init, i.e. viewport & shader are set once
+    glVerify(glViewport(0, 0, this->getWidth(), this->getHeight()));
+
+    shader.use();
+
+    for (int i = 0; i < iteration_num; ++i)
+    {
+        glVerify(glBindFramebuffer(GL_FRAMEBUFFER, this->dst().id()));
+
+#if __MACOS__
+        //NOTE: glInvalidateFramebuffer is not available on macOS (OpenGL 4.1), see GLFrameBuffer
+#else
+        //every texel is overwritten, tell tile-based GPUs not to load previous contents
+        const GLenum attachment = GL_COLOR_ATTACHMENT0;
+        glVerify(glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &attachment));
+#endif
+
+        //texture unit of the sampler is cached by the shader, only the texture binding changes
+        shader.setTexture(src_sampler_name, this->src());
+
+        if (per_iteration)
+            per_iteration(shader, i);
+
+        m_fullscreen_pass.draw();
+
+        this->swap();
+    }
+
+    shader.unUse();
+
+    glVerify(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+int GLPingPong::getWidth() const
+{
+    return m_fbos[0].getWidth();
+}
+
+int GLPingPong::getHeight() const
+{
+    return m_fbos[0].getHeight();
+}
+
+bool GLPingPong::isValid() const
+{
+    return m_fbos[0].id() != 0 && m_fbos[1].id() != 0;
+}
+
+}//end of namespace luna
@@ -0,0 +1,94 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: ping-pong frame buffer pair for iterative filters (diffusion, repeated blur, jacobi ...)
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "glm/glm.hpp"
+
+#include "gl_include.h"
+
+#include "gl_texture.h"
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+//NOTE: typical usage:
+//
+//    GLPingPong ping_pong(w, h, GL_RGBA16F);
+//    seed_pass.apply(input, ping_pong.dst());   //render initial state into dst, then
+//    ping_pong.swap();                          //src() holds the initial state
+//    ping_pong.iterate(jacobi_shader, 100);     //src() holds the result
+//
+//    Both targets are allocated once, nothing is cleared unless clear() is called,
+//    iterate() keeps shader, viewport and texture unit across iterations, i.e. each iteration is
+//    one fbo bind, one texture bind and one draw.
+
+class GLPingPong
+{
+public:
+
+    GLPingPong() = default;
+
+    GLPingPong(int width, int height, GLint internal_format = GL_RGBA8);
+
+    bool init(int width, int height, GLint internal_format = GL_RGBA8);
+
+    ~GLPingPong() = default;
+
+    void destroy();
+
+    //disable copy
+    GLPingPong(const GLPingPong& rhs) = delete;
+    GLPingPong& operator = (const GLPingPong& rhs) = delete;
+
+    //enable move
+    GLPingPong(GLPingPong&& rhs) noexcept = default;
+    GLPingPong& operator = (GLPingPong&& rhs) noexcept = default;
+
+    //-----------
+
+    //texture holding the latest result, i.e. input of the next iteration
+    GLTexture& src();
+
+    const GLTexture& src() const;
+
+    //target of the next iteration
+    GLFrameBuffer& dst();
+
+    void swap();
+
+    //clear both targets
+    void clear(const glm::vec4& color = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+
+    //run iteration_num full screen passes, src() is bound to src_sampler_name before each draw,
+    //per_iteration(shader, i) is called before each draw for iteration dependent uniforms,
+    //swap() is called after each draw, i.e. src() holds the result afterwards
+    void iterate(GLShader& shader,
+                 int iteration_num,
+                 const std::string& src_sampler_name = "u_tex_src",
+                 std::function<void(GLShader&, int)> per_iteration = nullptr);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    bool isValid() const;
+
+private:
+    GLFrameBuffer m_fbos[2];
+
+    int m_src_index = 0;
+
+    GLFullScreenPass m_fullscreen_pass;
+};
+
+}//end of namespace luna
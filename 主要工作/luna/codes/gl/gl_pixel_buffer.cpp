@@ -0,0 +1,156 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl pixel buffer (PBO)
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+
+#include "gl_pixel_buffer.h"
+
+namespace luna {
+
+GLPixelBuffer::GLPixelBuffer(GLenum target)
+    :m_target(target)
+{
+    glGenBuffers(1, &m_pbo_id);
+}
+
+GLPixelBuffer::GLPixelBuffer(GLPixelBuffer&& rhs) noexcept
+{
+    m_pbo_id = rhs.m_pbo_id;
+    m_target = rhs.m_target;
+    m_size = rhs.m_size;
+    m_is_mapped = rhs.m_is_mapped;
+
+    rhs.m_pbo_id = 0;
+    rhs.m_size = 0;
+    rhs.m_is_mapped = false;
+}
+
+GLPixelBuffer& GLPixelBuffer::operator=(GLPixelBuffer&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this->destroy();
+
+        m_pbo_id = rhs.m_pbo_id;
+        m_target = rhs.m_target;
+        m_size = rhs.m_size;
+        m_is_mapped = rhs.m_is_mapped;
+
+        rhs.m_pbo_id = 0;
+        rhs.m_size = 0;
+        rhs.m_is_mapped = false;
+    }
+    return *this;
+}
+
+GLPixelBuffer::~GLPixelBuffer()
+{
+    this->destroy();
+}
+
+void GLPixelBuffer::destroy()
+{
+    if (m_pbo_id != 0)
+    {
+        if (m_is_mapped)
+            this->unmap();
+
+        glDeleteBuffers(1, &m_pbo_id);
+        m_pbo_id = 0;
+        m_size = 0;
+    }
+}
+
+GLuint GLPixelBuffer::id() const
+{
+    return m_pbo_id;
+}
+
+GLenum GLPixelBuffer::target() const
+{
+    return m_target;
+}
+
+int GLPixelBuffer::size() const
+{
+    return m_size;
+}
+
+void GLPixelBuffer::update(const void* data, int size, GLenum usage)
+{
+    glBindBuffer(m_target, m_pbo_id);
+    glVerify(glBufferData(m_target, size, data, usage));
+    m_size = size;
+}
+
+void* GLPixelBuffer::map(GLbitfield access)
+{
+    return this->map(0, m_size, access);
+}
+
+void* GLPixelBuffer::map(int offset, int length, GLbitfield access)
+{
+    if (m_is_mapped)
+    {
+        LOGE("error: pixel buffer is already mapped");
+        throw std::runtime_error("error: pixel buffer is already mapped");
+    }
+
+    if (offset < 0 || length <= 0 || offset + length > m_size)
+    {
+        LOGE("error: invalid map range, offset: %d, length: %d, size: %d", offset, length, m_size);
+        throw std::invalid_argument("error: invalid map range");
+    }
+
+    glBindBuffer(m_target, m_pbo_id);
+
+    void* ptr = glMapBufferRange(m_target, offset, length, access);
+    if (ptr == nullptr)
+    {
+        LOGE("error: can not map pixel buffer");
+        return nullptr;
+    }
+
+    m_is_mapped = true;
+
+    return ptr;
+}
+
+bool GLPixelBuffer::unmap()
+{
+    if (!m_is_mapped)
+        return false;
+
+    glBindBuffer(m_target, m_pbo_id);
+
+    //NOTE: returns GL_FALSE if buffer contents are corrupted (e.g. screen mode change)
+    GLboolean succ = glUnmapBuffer(m_target);
+    m_is_mapped = false;
+
+    return succ == GL_TRUE;
+}
+
+bool GLPixelBuffer::isMapped() const
+{
+    return m_is_mapped;
+}
+
+void GLPixelBuffer::bind() const
+{
+    glBindBuffer(m_target, m_pbo_id);
+}
+
+void GLPixelBuffer::unbind() const
+{
+    glBindBuffer(m_target, 0);
+}
+
+}//end of namespace luna
@@ -0,0 +1,66 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl pixel buffer (PBO)
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "gl_include.h"
+
+namespace luna{
+
+class GLPixelBuffer
+{
+public:
+
+    //target: GL_PIXEL_UNPACK_BUFFER for upload, GL_PIXEL_PACK_BUFFER for readback
+    explicit GLPixelBuffer(GLenum target = GL_PIXEL_UNPACK_BUFFER);
+
+    ~GLPixelBuffer();
+
+    //disable copy
+    GLPixelBuffer(const GLPixelBuffer& rhs) = delete;
+    GLPixelBuffer& operator = (const GLPixelBuffer& rhs) = delete;
+
+    //enable move
+    GLPixelBuffer(GLPixelBuffer&& rhs) noexcept;
+    GLPixelBuffer& operator = (GLPixelBuffer&& rhs) noexcept;
+
+    void destroy();
+
+    GLuint id() const;
+
+    GLenum target() const;
+
+    int size() const;
+
+    void update(const void* data, int size, GLenum usage = GL_STREAM_DRAW);
+
+    //map whole buffer, buffer is left bound
+    void* map(GLbitfield access);
+
+    void* map(int offset, int length, GLbitfield access);
+
+    bool unmap();
+
+    bool isMapped() const;
+
+    void bind() const;
+
+    void unbind() const;
+
+private:
+    GLuint m_pbo_id = 0;
+
+    GLenum m_target = GL_PIXEL_UNPACK_BUFFER;
+
+    int m_size = 0;
+
+    bool m_is_mapped = false;
+};
+
+using GLPBO = GLPixelBuffer;
+
+}//end of namespace luna
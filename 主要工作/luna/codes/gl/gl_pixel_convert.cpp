@@ -0,0 +1,614 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: cpu pixel conversion for texture upload/readback
+ * @version    : 1.0
+ */
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LUNA_PIXEL_CONVERT_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define LUNA_PIXEL_CONVERT_NEON 1
+    #include <arm_neon.h>
+#endif
+
+//NOTE: SIMD kernels are compiled by function target attribute, i.e. no global -mavx2 is needed,
+//      and only called after runtime cpu feature check. MSVC allows intrinsics without any flag.
+#if defined(LUNA_PIXEL_CONVERT_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define LUNA_TARGET_SSE4 __attribute__((target("ssse3,sse4.1")))
+    #define LUNA_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#else
+    #define LUNA_TARGET_SSE4
+    #define LUNA_TARGET_AVX2
+#endif
+
+#include "gl_pixel_convert.h"
+
+namespace luna {
+
+namespace {
+
+struct RowKernels
+{
+    void (*rgba_to_rgb)(const uint8_t* src, uint8_t* dst, size_t pixel_num);
+    void (*rgba_to_bgr)(const uint8_t* src, uint8_t* dst, size_t pixel_num);
+    void (*swap_red_blue_3)(const uint8_t* src, uint8_t* dst, size_t pixel_num);
+    void (*swap_red_blue_4)(const uint8_t* src, uint8_t* dst, size_t pixel_num);
+    void (*u8_to_float)(const uint8_t* src, float* dst, size_t count);
+    void (*float_to_half)(const float* src, uint16_t* dst, size_t count);
+    void (*half_to_float)(const uint16_t* src, float* dst, size_t count);
+
+    const char* name;
+};
+
+constexpr float U8_TO_FLOAT_SCALE = 1.0f / 255.0f;
+
+//-----------
+//scalar reference
+
+void rgbaToRGBScalar(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    for (size_t i = 0; i < pixel_num; ++i)
+    {
+        dst[3 * i + 0] = src[4 * i + 0];
+        dst[3 * i + 1] = src[4 * i + 1];
+        dst[3 * i + 2] = src[4 * i + 2];
+    }
+}
+
+void rgbaToBGRScalar(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    for (size_t i = 0; i < pixel_num; ++i)
+    {
+        dst[3 * i + 0] = src[4 * i + 2];
+        dst[3 * i + 1] = src[4 * i + 1];
+        dst[3 * i + 2] = src[4 * i + 0];
+    }
+}
+
+void swapRedBlue3Scalar(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    for (size_t i = 0; i < pixel_num; ++i)
+    {
+        dst[3 * i + 0] = src[3 * i + 2];
+        dst[3 * i + 1] = src[3 * i + 1];
+        dst[3 * i + 2] = src[3 * i + 0];
+    }
+}
+
+void swapRedBlue4Scalar(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    for (size_t i = 0; i < pixel_num; ++i)
+    {
+        dst[4 * i + 0] = src[4 * i + 2];
+        dst[4 * i + 1] = src[4 * i + 1];
+        dst[4 * i + 2] = src[4 * i + 0];
+        dst[4 * i + 3] = src[4 * i + 3];
+    }
+}
+
+void u8ToFloatScalar(const uint8_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]) * U8_TO_FLOAT_SCALE;
+}
+
+void floatToHalfScalar(const float* src, uint16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = floatToHalf(src[i]);
+}
+
+void halfToFloatScalar(const uint16_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = halfToFloat(src[i]);
+}
+
+#if LUNA_PIXEL_CONVERT_X86
+
+//-----------
+//SSE4 (SSSE3 pshufb + SSE4.1 pmovzx)
+
+//16 RGBA pixels -> 48 bytes, each register is shuffled to 12 bytes and merged by byte shifts
+LUNA_TARGET_SSE4 void dropAlphaSSE4(const uint8_t* src, uint8_t* dst, size_t pixel_num, __m128i mask,
+                                    void (*tail)(const uint8_t*, uint8_t*, size_t))
+{
+    size_t i = 0;
+
+    for (; i + 16 <= pixel_num; i += 16)
+    {
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i)), mask);
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i + 16)), mask);
+        const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i + 32)), mask);
+        const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i + 48)), mask);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+    }
+
+    tail(src + 4 * i, dst + 3 * i, pixel_num - i);
+}
+
+LUNA_TARGET_SSE4 void rgbaToRGBSSE4(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    dropAlphaSSE4(src, dst, pixel_num, mask, rgbaToRGBScalar);
+}
+
+LUNA_TARGET_SSE4 void rgbaToBGRSSE4(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    dropAlphaSSE4(src, dst, pixel_num, mask, rgbaToBGRScalar);
+}
+
+//5 RGB pixels (15 bytes) per 16-byte register, byte 15 is rewritten by the next step,
+//so the vector loop stops while at least 16 bytes remain readable & writable
+LUNA_TARGET_SSE4 void swapRedBlue3SSE4(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+
+    size_t i = 0;
+
+    for (; i + 6 <= pixel_num; i += 5)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i), _mm_shuffle_epi8(v, mask));
+    }
+
+    swapRedBlue3Scalar(src + 3 * i, dst + 3 * i, pixel_num - i);
+}
+
+LUNA_TARGET_SSE4 void swapRedBlue4SSE4(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    size_t i = 0;
+
+    for (; i + 4 <= pixel_num; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_shuffle_epi8(v, mask));
+    }
+
+    swapRedBlue4Scalar(src + 4 * i, dst + 4 * i, pixel_num - i);
+}
+
+LUNA_TARGET_SSE4 void u8ToFloatSSE4(const uint8_t* src, float* dst, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(U8_TO_FLOAT_SCALE);
+
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        _mm_storeu_ps(dst + i,      _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(v)), scale));
+        _mm_storeu_ps(dst + i + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4))), scale));
+        _mm_storeu_ps(dst + i + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12))), scale));
+    }
+
+    u8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+//-----------
+//AVX2 + F16C
+
+LUNA_TARGET_AVX2 void u8ToFloatAVX2(const uint8_t* src, float* dst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(U8_TO_FLOAT_SCALE);
+
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        _mm256_storeu_ps(dst + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+    }
+
+    u8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+LUNA_TARGET_AVX2 void floatToHalfAVX2(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+
+    floatToHalfScalar(src + i, dst + i, count - i);
+}
+
+LUNA_TARGET_AVX2 void halfToFloatAVX2(const uint16_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+
+    halfToFloatScalar(src + i, dst + i, count - i);
+}
+
+//-----------
+//cpu features
+
+#if defined(_MSC_VER)
+
+bool hasCPUFeature(int leaf, int reg, int bit)
+{
+    int info[4] = { 0 };
+    __cpuidex(info, leaf, 0);
+    return (info[reg] >> bit) & 1;
+}
+
+bool hasSSE4()
+{
+    return hasCPUFeature(1, 2, 9) && hasCPUFeature(1, 2, 19); //SSSE3, SSE4.1
+}
+
+bool hasAVX2()
+{
+    //AVX state must be enabled by os (OSXSAVE & XCR0)
+    if (!hasCPUFeature(1, 2, 27) || !hasCPUFeature(1, 2, 28) || !hasCPUFeature(1, 2, 29)) //OSXSAVE, AVX, F16C
+        return false;
+
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    return hasCPUFeature(7, 1, 5); //AVX2
+}
+
+#else
+
+bool hasSSE4()
+{
+    return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+}
+
+bool hasAVX2()
+{
+    //NOTE: no __builtin_cpu_supports("f16c") on older gcc, all AVX2 cpus (Haswell, Excavator & later) have F16C
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+#endif //LUNA_PIXEL_CONVERT_X86
+
+#if LUNA_PIXEL_CONVERT_NEON
+
+//-----------
+//NEON, interleaved load/store de-interleave channels for free
+
+void rgbaToRGBNEON(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= pixel_num; i += 16)
+    {
+        const uint8x16x4_t rgba = vld4q_u8(src + 4 * i);
+
+        uint8x16x3_t rgb;
+        rgb.val[0] = rgba.val[0];
+        rgb.val[1] = rgba.val[1];
+        rgb.val[2] = rgba.val[2];
+
+        vst3q_u8(dst + 3 * i, rgb);
+    }
+
+    rgbaToRGBScalar(src + 4 * i, dst + 3 * i, pixel_num - i);
+}
+
+void rgbaToBGRNEON(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= pixel_num; i += 16)
+    {
+        const uint8x16x4_t rgba = vld4q_u8(src + 4 * i);
+
+        uint8x16x3_t bgr;
+        bgr.val[0] = rgba.val[2];
+        bgr.val[1] = rgba.val[1];
+        bgr.val[2] = rgba.val[0];
+
+        vst3q_u8(dst + 3 * i, bgr);
+    }
+
+    rgbaToBGRScalar(src + 4 * i, dst + 3 * i, pixel_num - i);
+}
+
+void swapRedBlue3NEON(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= pixel_num; i += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(src + 3 * i);
+
+        const uint8x16_t red = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = red;
+
+        vst3q_u8(dst + 3 * i, v);
+    }
+
+    swapRedBlue3Scalar(src + 3 * i, dst + 3 * i, pixel_num - i);
+}
+
+void swapRedBlue4NEON(const uint8_t* src, uint8_t* dst, size_t pixel_num)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= pixel_num; i += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(src + 4 * i);
+
+        const uint8x16_t red = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = red;
+
+        vst4q_u8(dst + 4 * i, v);
+    }
+
+    swapRedBlue4Scalar(src + 4 * i, dst + 4 * i, pixel_num - i);
+}
+
+void u8ToFloatNEON(const uint8_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16_t v = vld1q_u8(src + i);
+
+        const uint16x8_t low = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t high = vmovl_u8(vget_high_u8(v));
+
+        vst1q_f32(dst + i,      vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(low))), U8_TO_FLOAT_SCALE));
+        vst1q_f32(dst + i + 4,  vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(low))), U8_TO_FLOAT_SCALE));
+        vst1q_f32(dst + i + 8,  vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(high))), U8_TO_FLOAT_SCALE));
+        vst1q_f32(dst + i + 12, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(high))), U8_TO_FLOAT_SCALE));
+    }
+
+    u8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+#if defined(__aarch64__)
+
+//NOTE: half conversion instructions are mandatory on armv8, optional on armv7 (scalar fallback)
+
+void floatToHalfNEON(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+
+    floatToHalfScalar(src + i, dst + i, count - i);
+}
+
+void halfToFloatNEON(const uint16_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+
+    halfToFloatScalar(src + i, dst + i, count - i);
+}
+
+#endif //__aarch64__
+
+#endif //LUNA_PIXEL_CONVERT_NEON
+
+RowKernels selectRowKernels()
+{
+    RowKernels kernels = { rgbaToRGBScalar, rgbaToBGRScalar, swapRedBlue3Scalar, swapRedBlue4Scalar,
+                           u8ToFloatScalar, floatToHalfScalar, halfToFloatScalar, "scalar" };
+
+#if LUNA_PIXEL_CONVERT_X86
+    if (hasSSE4())
+    {
+        kernels.rgba_to_rgb = rgbaToRGBSSE4;
+        kernels.rgba_to_bgr = rgbaToBGRSSE4;
+        kernels.swap_red_blue_3 = swapRedBlue3SSE4;
+        kernels.swap_red_blue_4 = swapRedBlue4SSE4;
+        kernels.u8_to_float = u8ToFloatSSE4;
+        kernels.name = "sse4";
+
+        //byte shuffles stay 128-bit, pshufb does not cross 128-bit lanes
+        if (hasAVX2())
+        {
+            kernels.u8_to_float = u8ToFloatAVX2;
+            kernels.float_to_half = floatToHalfAVX2;
+            kernels.half_to_float = halfToFloatAVX2;
+            kernels.name = "avx2";
+        }
+    }
+#elif LUNA_PIXEL_CONVERT_NEON
+    kernels.rgba_to_rgb = rgbaToRGBNEON;
+    kernels.rgba_to_bgr = rgbaToBGRNEON;
+    kernels.swap_red_blue_3 = swapRedBlue3NEON;
+    kernels.swap_red_blue_4 = swapRedBlue4NEON;
+    kernels.u8_to_float = u8ToFloatNEON;
+#if defined(__aarch64__)
+    kernels.float_to_half = floatToHalfNEON;
+    kernels.half_to_float = halfToFloatNEON;
+#endif
+    kernels.name = "neon";
+#endif
+
+    return kernels;
+}
+
+const RowKernels& getRowKernels()
+{
+    static const RowKernels kernels = selectRowKernels();
+    return kernels;
+}
+
+}//end of anonymous namespace
+
+void convertImage(const void* src, size_t src_step,
+                  void* dst, size_t dst_step,
+                  int width, int height, int channel_num,
+                  PixelConversion conversion,
+                  bool vertical_flip)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    const RowKernels& kernels = getRowKernels();
+
+    const size_t pixel_num = static_cast<size_t>(width);
+    const size_t element_num = pixel_num * channel_num;
+
+    for (int row = 0; row < height; ++row)
+    {
+        const int src_row = vertical_flip ? (height - 1 - row) : row;
+
+        const uint8_t* src_ptr = static_cast<const uint8_t*>(src) + src_row * src_step;
+        uint8_t* dst_ptr = static_cast<uint8_t*>(dst) + row * dst_step;
+
+        switch (conversion)
+        {
+        case PixelConversion::COPY:
+            std::memcpy(dst_ptr, src_ptr, element_num);
+            break;
+        case PixelConversion::RGBA_TO_RGB:
+            kernels.rgba_to_rgb(src_ptr, dst_ptr, pixel_num);
+            break;
+        case PixelConversion::RGBA_TO_BGR:
+            kernels.rgba_to_bgr(src_ptr, dst_ptr, pixel_num);
+            break;
+        case PixelConversion::SWAP_RED_BLUE:
+            if (channel_num == 4)
+                kernels.swap_red_blue_4(src_ptr, dst_ptr, pixel_num);
+            else
+                kernels.swap_red_blue_3(src_ptr, dst_ptr, pixel_num);
+            break;
+        case PixelConversion::U8_TO_FLOAT:
+            kernels.u8_to_float(src_ptr, reinterpret_cast<float*>(dst_ptr), element_num);
+            break;
+        case PixelConversion::FLOAT_TO_HALF:
+            kernels.float_to_half(reinterpret_cast<const float*>(src_ptr), reinterpret_cast<uint16_t*>(dst_ptr), element_num);
+            break;
+        case PixelConversion::HALF_TO_FLOAT:
+            kernels.half_to_float(reinterpret_cast<const uint16_t*>(src_ptr), reinterpret_cast<float*>(dst_ptr), element_num);
+            break;
+        }
+    }
+}
+
+const char* getPixelConvertBackend()
+{
+    return getRowKernels().name;
+}
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t abs_bits = bits & 0x7FFFFFFF;
+
+    if (abs_bits == 0x7F800000)
+        return static_cast<uint16_t>(sign | 0x7C00);
+
+    //nan made quiet, top 10 bits of the payload are kept (same as F16C & NEON)
+    if (abs_bits > 0x7F800000)
+        return static_cast<uint16_t>(sign | 0x7C00 | 0x0200 | ((abs_bits >> 13) & 0x03FF));
+
+    //>= 65520 rounds to inf
+    if (abs_bits >= 0x477FF000)
+        return static_cast<uint16_t>(sign | 0x7C00);
+
+    //below smallest normal half (2^-14), i.e. denormal or zero
+    if (abs_bits < 0x38800000)
+    {
+        //<= 2^-25 rounds to zero
+        if (abs_bits <= 0x33000000)
+            return static_cast<uint16_t>(sign);
+
+        const uint32_t exponent = abs_bits >> 23;
+        const uint32_t mantissa = (abs_bits & 0x007FFFFF) | 0x00800000;
+
+        const uint32_t shift = 126 - exponent;
+        const uint32_t halfway = 1u << (shift - 1);
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+
+        uint32_t half = mantissa >> shift;
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+            ++half;
+
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    //normal, rebias exponent from 127 to 15, carry of rounding into exponent is correct
+    uint32_t half = (abs_bits - 0x38000000) >> 13;
+    const uint32_t remainder = abs_bits & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+        ++half;
+
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value)
+{
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x03FF;
+
+    uint32_t bits = 0;
+
+    if (exponent == 0)
+    {
+        //zero or denormal, i.e. mantissa * 2^-24
+        const float result = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+        return sign ? -result : result;
+    }
+    else if (exponent == 31)
+    {
+        //inf, or nan made quiet (same as F16C & NEON)
+        bits = sign | 0x7F800000 | (mantissa << 13) | (mantissa ? 0x00400000 : 0);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void convertFloatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+    getRowKernels().float_to_half(src, dst, count);
+}
+
+void convertHalfToFloat(const uint16_t* src, float* dst, size_t count)
+{
+    getRowKernels().half_to_float(src, dst, count);
+}
+
+}//end of namespace luna
@@ -0,0 +1,179 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: fuse chained point-wise passes (exposure, curve, saturation, lut ...) into a single fragment shader
+ * @version    : 1.0
+ */
+
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_texture.h"
+#include "gl_render_pass.h"
+
+#include "gl_point_pass_composer.h"
+
+namespace luna {
+
+void GLPointPassComposer::registerOp(const std::string& function_name, const std::string& source)
+{
+    if (function_name.empty() || function_name.find('|') != std::string::npos)
+    {
+        LOGE("error: invalid point op name: %s", function_name.c_str());
+        throw std::invalid_argument("error: invalid point op name");
+    }
+
+    if (source.find(function_name) == std::string::npos)
+    {
+        LOGE("error: source of point op %s does not define vec4 %s(vec4)", function_name.c_str(), function_name.c_str());
+        throw std::invalid_argument("error: source of point op does not define its function");
+    }
+
+    //drop fused shaders built from the former source
+    if (m_op_sources.find(function_name) != m_op_sources.end())
+    {
+        for (auto iter = m_shader_cache.begin(); iter != m_shader_cache.end();)
+        {
+            if (("|" + iter->first + "|").find("|" + function_name + "|") != std::string::npos)
+                iter = m_shader_cache.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    m_op_sources[function_name] = source;
+}
+
+bool GLPointPassComposer::hasOp(const std::string& function_name) const
+{
+    return m_op_sources.find(function_name) != m_op_sources.end();
+}
+
+GLShader& GLPointPassComposer::getShader(const std::vector<std::string>& chain)
+{
+    const std::string key = getChainKey(chain);
+
+    auto iter = m_shader_cache.find(key);
+    if (iter != m_shader_cache.end())
+        return *iter->second;
+
+    auto shader = std::make_unique<GLShader>();
+    shader->createFromString(GLFullScreenPass::getVertexShaderSource(), this->composeFragmentShader(chain));
+
+    GLShader& result = *shader;
+    m_shader_cache[key] = std::move(shader);
+
+    return result;
+}
+
+bool GLPointPassComposer::apply(const GLTexture& src,
+                                GLFrameBuffer& dst,
+                                const std::vector<std::string>& chain,
+                                std::function<void(GLShader&)> set_uniforms)
+{
+    if (!src.isValid())
+    {
+        LOGE("error: invalid src texture");
+        throw std::invalid_argument("error: invalid src texture");
+        return false;
+    }
+
+    if (src.getMultiSample() > 1)
+    {
+        LOGE("error: multi-sample texture can not be sampled, resolve it first");
+        throw std::invalid_argument("error: multi-sample texture can not be sampled");
+        return false;
+    }
+
+    GLShader& shader = this->getShader(chain);
+
+    //every texel is overwritten
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::DONT_CARE;
+
+    dst.beginRenderPass(render_pass);
+
+    shader.use();
+    shader.setTexture("u_tex_src", src);
+    GLFullScreenPass::setTexCoordFlip(shader, src.isVerticalFlipped());
+
+    if (set_uniforms)
+        set_uniforms(shader);
+
+    m_fullscreen_pass.draw();
+
+    shader.unUse();
+
+    dst.endRenderPass();
+
+    return true;
+}
+
+std::string GLPointPassComposer::composeFragmentShader(const std::vector<std::string>& chain) const
+{
+    std::ostringstream oss;
+
+    oss << "precision highp float;\n"
+        << "\n"
+        << "in vec2 v_tex_coord;\n"
+        << "\n"
+        << "uniform sampler2D u_tex_src;\n"
+        << "\n"
+        << "out vec4 frag_color;\n"
+        << "\n";
+
+    //an op used several times in a chain is defined once
+    std::set<std::string> defined_ops;
+    for (const std::string& op : chain)
+    {
+        auto iter = m_op_sources.find(op);
+        if (iter == m_op_sources.end())
+        {
+            LOGE("error: unknown point op: %s", op.c_str());
+            throw std::invalid_argument("error: unknown point op");
+        }
+
+        if (defined_ops.insert(op).second)
+            oss << "//---- " << op << "\n" << iter->second << "\n\n";
+    }
+
+    oss << "void main()\n"
+        << "{\n"
+        << "    vec4 color = texture(u_tex_src, v_tex_coord);\n";
+
+    for (const std::string& op : chain)
+        oss << "    color = " << op << "(color);\n";
+
+    oss << "    frag_color = color;\n"
+        << "}\n";
+
+    return oss.str();
+}
+
+int GLPointPassComposer::getCachedShaderNum() const
+{
+    return static_cast<int>(m_shader_cache.size());
+}
+
+void GLPointPassComposer::clearCache()
+{
+    m_shader_cache.clear();
+}
+
+std::string GLPointPassComposer::getChainKey(const std::vector<std::string>& chain)
+{
+    std::string key;
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        if (i > 0)
+            key += "|";
+        key += chain[i];
+    }
+
+    return key;
+}
+
+}//end of namespace luna
@@ -0,0 +1,91 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: fuse chained point-wise passes (exposure, curve, saturation, lut ...) into a single fragment shader
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gl_include.h"
+
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+class GLTexture;
+
+//NOTE: a point op only depends on the color of the same pixel, i.e. a chain of N point passes
+//      can be evaluated in one pass, which saves N - 1 full-frame writes & reads.
+//
+//    composer.registerOp("exposure", R"(
+//        uniform float u_exposure;
+//        vec4 exposure(vec4 color) { return vec4(color.rgb * exp2(u_exposure), color.a); }
+//    )");
+//    composer.apply(src, dst, {"exposure", "saturation"}, [](GLShader& shader) { shader.setFloat("u_exposure", 0.5f); });
+//
+//    Source of an op defines "vec4 <function_name>(vec4 color)" and the uniforms it needs (samplers are fine, e.g. lut),
+//    all ops share one program, so uniform & helper names must be unique among ops of a chain.
+//    Fused shaders are cached per chain, getShader(chain) can also be used as pass shader of GLRenderGraph ("u_tex_src").
+
+class GLPointPassComposer
+{
+public:
+
+    GLPointPassComposer() = default;
+
+    ~GLPointPassComposer() = default;
+
+    //disable copy
+    GLPointPassComposer(const GLPointPassComposer& rhs) = delete;
+    GLPointPassComposer& operator = (const GLPointPassComposer& rhs) = delete;
+
+    //enable move
+    GLPointPassComposer(GLPointPassComposer&& rhs) noexcept = default;
+    GLPointPassComposer& operator = (GLPointPassComposer&& rhs) noexcept = default;
+
+    //-----------
+
+    //register (or replace) a point op, cached shaders using a replaced op are dropped
+    void registerOp(const std::string& function_name, const std::string& source);
+
+    bool hasOp(const std::string& function_name) const;
+
+    //fused shader of chain (ops applied from first to last), compiled on first use
+    GLShader& getShader(const std::vector<std::string>& chain);
+
+    //sample src ("u_tex_src"), apply chain and write dst in a single pass,
+    //set_uniforms is called with the fused shader in use, i.e. set uniforms of all ops there
+    bool apply(const GLTexture& src,
+               GLFrameBuffer& dst,
+               const std::vector<std::string>& chain,
+               std::function<void(GLShader&)> set_uniforms = nullptr);
+
+    //generated fragment shader source of chain, for debugging
+    std::string composeFragmentShader(const std::vector<std::string>& chain) const;
+
+    int getCachedShaderNum() const;
+
+    void clearCache();
+
+private:
+
+    static std::string getChainKey(const std::vector<std::string>& chain);
+
+private:
+    std::map<std::string, std::string> m_op_sources; //function name -> source
+
+    std::map<std::string, std::unique_ptr<GLShader>> m_shader_cache; //chain key -> fused shader
+
+    GLFullScreenPass m_fullscreen_pass;
+};
+
+}//end of namespace luna
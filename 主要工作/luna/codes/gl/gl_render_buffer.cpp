@@ -0,0 +1,163 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl render buffer, i.e. render-only (not sampleable) attachment storage
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+
+#include "gl_render_buffer.h"
+
+namespace luna {
+
+GLRenderBuffer::GLRenderBuffer(int width, int height, GLint internal_format, unsigned int multi_sample)
+{
+    bool succ = this->init(width, height, internal_format, multi_sample);
+    if (!succ)
+    {
+        LOGE("error: can not init GLRenderBuffer");
+        throw std::invalid_argument("error: can not init GLRenderBuffer");
+    }
+}
+
+bool GLRenderBuffer::init(int width, int height, GLint internal_format, unsigned int multi_sample)
+{
+    if (width <= 0 || height <= 0)
+    {
+        LOGE("error: invalid render buffer size: %d x %d", width, height);
+        throw std::invalid_argument("error: invalid render buffer size");
+        return false;
+    }
+
+    //destroy if necessary
+    this->destroy();
+
+    GLint max_samples = 1;
+    glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+
+    if (multi_sample > static_cast<unsigned int>(max_samples))
+    {
+        LOGE("Error: multi_sample(%d) exceeds GL_MAX_SAMPLES(%d), clamped", multi_sample, max_samples);
+        multi_sample = max_samples;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_internal_format = internal_format;
+    m_multi_sample = multi_sample > 1 ? multi_sample : 1;
+
+    glVerify(glGenRenderbuffers(1, &m_rbo_id));
+    glVerify(glBindRenderbuffer(GL_RENDERBUFFER, m_rbo_id));
+
+    if (m_multi_sample > 1)
+        glVerify(glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_multi_sample, m_internal_format, m_width, m_height));
+    else
+        glVerify(glRenderbufferStorage(GL_RENDERBUFFER, m_internal_format, m_width, m_height));
+
+    glVerify(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+
+    return true;
+}
+
+GLRenderBuffer::~GLRenderBuffer()
+{
+    this->destroy();
+}
+
+void GLRenderBuffer::destroy()
+{
+    if (m_rbo_id != 0)
+    {
+        glDeleteRenderbuffers(1, &m_rbo_id);
+        m_rbo_id = 0;
+
+        m_width = 0;
+        m_height = 0;
+        m_internal_format = 0;
+        m_multi_sample = 1;
+    }
+}
+
+GLRenderBuffer::GLRenderBuffer(GLRenderBuffer&& rhs) noexcept
+{
+    m_rbo_id = rhs.m_rbo_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_internal_format = rhs.m_internal_format;
+    m_multi_sample = rhs.m_multi_sample;
+
+    rhs.m_rbo_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_internal_format = 0;
+    rhs.m_multi_sample = 1;
+}
+
+GLRenderBuffer& GLRenderBuffer::operator = (GLRenderBuffer&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_rbo_id = rhs.m_rbo_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_internal_format = rhs.m_internal_format;
+    m_multi_sample = rhs.m_multi_sample;
+
+    rhs.m_rbo_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_internal_format = 0;
+    rhs.m_multi_sample = 1;
+
+    return *this;
+}
+
+void GLRenderBuffer::bind() const
+{
+    glVerify(glBindRenderbuffer(GL_RENDERBUFFER, m_rbo_id));
+}
+
+void GLRenderBuffer::unbind() const
+{
+    glVerify(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+}
+
+GLuint GLRenderBuffer::id() const
+{
+    return m_rbo_id;
+}
+
+int GLRenderBuffer::getWidth() const
+{
+    return m_width;
+}
+
+int GLRenderBuffer::getHeight() const
+{
+    return m_height;
+}
+
+GLint GLRenderBuffer::getInternalFormat() const
+{
+    return m_internal_format;
+}
+
+unsigned int GLRenderBuffer::getMultiSample() const
+{
+    return m_multi_sample;
+}
+
+bool GLRenderBuffer::isValid() const
+{
+    return m_rbo_id != 0;
+}
+
+}//end of namespace luna
@@ -0,0 +1,69 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl render buffer, i.e. render-only (not sampleable) attachment storage
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "gl_include.h"
+
+namespace luna {
+
+//NOTE: render buffers can not be sampled, but multi-sample render buffers are cheaper than multi-sample
+//      textures (tile-based GPUs may keep samples in tile memory only) and are supported by OpenGLES 3.0 (ios),
+//      read/sample them after resolving into a single-sample texture, see GLFrameBuffer.
+
+class GLRenderBuffer
+{
+public:
+
+    GLRenderBuffer() = default;
+
+    GLRenderBuffer(int width, int height, GLint internal_format, unsigned int multi_sample = 1);
+
+    bool init(int width, int height, GLint internal_format, unsigned int multi_sample = 1);
+
+    ~GLRenderBuffer();
+
+    void destroy();
+
+    //disable copy
+    GLRenderBuffer(const GLRenderBuffer& rhs) = delete;
+    GLRenderBuffer& operator = (const GLRenderBuffer& rhs) = delete;
+
+    //enable move
+    GLRenderBuffer(GLRenderBuffer&& rhs) noexcept;
+    GLRenderBuffer& operator = (GLRenderBuffer&& rhs) noexcept;
+
+    //-----------
+
+    void bind() const;
+
+    void unbind() const;
+
+    GLuint id() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    GLint getInternalFormat() const;
+
+    unsigned int getMultiSample() const; //actual sample count, may be clamped to GL_MAX_SAMPLES
+
+    bool isValid() const;
+
+private:
+    GLuint m_rbo_id = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+
+    GLint m_internal_format = 0;
+
+    unsigned int m_multi_sample = 1;
+};
+
+}//end of namespace luna
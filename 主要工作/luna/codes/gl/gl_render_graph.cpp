@@ -0,0 +1,392 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: declarative full screen pass graph, culls unused passes & aliases intermediate textures
+ * @version    : 1.0
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_render_graph.h"
+
+namespace luna {
+
+GLRenderGraph::GLRenderGraph(GLResourcePool* pool)
+    : m_pool(pool)
+{
+    if (m_pool == nullptr)
+    {
+        m_own_pool = std::make_unique<GLResourcePool>();
+        m_pool = m_own_pool.get();
+    }
+}
+
+int GLRenderGraph::createTexture(const std::string& name, int width, int height, GLint internal_format)
+{
+    if (width <= 0 || height <= 0)
+    {
+        LOGE("error: invalid size of render graph texture %s: %d x %d", name.c_str(), width, height);
+        throw std::invalid_argument("error: invalid size of render graph texture");
+        return -1;
+    }
+
+    TextureNode node;
+    node.name = name;
+    node.width = width;
+    node.height = height;
+    node.internal_format = internal_format;
+
+    m_textures.push_back(std::move(node));
+    m_compiled = false;
+
+    return static_cast<int>(m_textures.size()) - 1;
+}
+
+int GLRenderGraph::importTexture(const std::string& name, GLTexture& texture)
+{
+    if (!texture.isValid())
+    {
+        LOGE("error: can not import invalid texture %s", name.c_str());
+        throw std::invalid_argument("error: can not import invalid texture");
+        return -1;
+    }
+
+    TextureNode node;
+    node.name = name;
+    node.width = texture.getWidth();
+    node.height = texture.getHeight();
+    node.internal_format = texture.getInternalFormat();
+    node.imported = &texture;
+
+    m_textures.push_back(std::move(node));
+    m_compiled = false;
+
+    return static_cast<int>(m_textures.size()) - 1;
+}
+
+void GLRenderGraph::markOutput(int texture)
+{
+    this->checkTextureHandle(texture);
+
+    m_textures[texture].is_output = true;
+    m_compiled = false;
+}
+
+int GLRenderGraph::addPass(const std::string& name,
+                           GLShader& shader,
+                           const std::vector<GLRenderGraphInput>& inputs,
+                           const std::vector<int>& outputs,
+                           std::function<void(GLShader&)> set_uniforms)
+{
+    PassNode node;
+    node.name = name;
+    node.shader = &shader;
+    node.inputs = inputs;
+    node.outputs = outputs;
+    node.set_uniforms = std::move(set_uniforms);
+
+    m_passes.push_back(std::move(node));
+    m_compiled = false;
+
+    return static_cast<int>(m_passes.size()) - 1;
+}
+
+void GLRenderGraph::compile()
+{
+    this->validate();
+
+    this->cullPasses();
+
+    this->assignPhysicalTextures();
+
+    m_compiled = true;
+}
+
+void GLRenderGraph::execute()
+{
+    if (!m_compiled)
+        this->compile();
+
+    for (PassNode& pass : m_passes)
+    {
+        if (pass.culled)
+            continue;
+
+        pass.frame_buffer.beginRenderPass(pass.render_pass);
+
+        pass.shader->use();
+
+        for (const GLRenderGraphInput& input : pass.inputs)
+            pass.shader->setTexture(input.sampler_name, this->resolveTexture(input.texture));
+
+        //v_tex_coord follows the first input, e.g. an imported FLIP_TEXCOORD texture, outputs are always upright
+        const bool flip_tex_coord = !pass.inputs.empty() && this->resolveTexture(pass.inputs[0].texture).isVerticalFlipped();
+        GLFullScreenPass::setTexCoordFlip(*pass.shader, flip_tex_coord);
+
+        if (pass.set_uniforms)
+            pass.set_uniforms(*pass.shader);
+
+        m_fullscreen_pass.draw();
+
+        pass.shader->unUse();
+
+        pass.frame_buffer.endRenderPass();
+    }
+}
+
+void GLRenderGraph::reset()
+{
+    //fbo wraps physical textures, destroy it first
+    m_passes.clear();
+    m_physical_textures.clear();
+    m_textures.clear();
+
+    m_compiled = false;
+}
+
+GLTexture& GLRenderGraph::getTexture(int texture)
+{
+    this->checkTextureHandle(texture);
+
+    if (!m_compiled)
+    {
+        LOGE("error: render graph is not compiled");
+        throw std::runtime_error("error: render graph is not compiled");
+    }
+
+    return this->resolveTexture(texture);
+}
+
+bool GLRenderGraph::isCompiled() const
+{
+    return m_compiled;
+}
+
+bool GLRenderGraph::isPassCulled(int pass) const
+{
+    if (pass < 0 || pass >= static_cast<int>(m_passes.size()))
+    {
+        LOGE("error: invalid render graph pass: %d", pass);
+        throw std::invalid_argument("error: invalid render graph pass");
+    }
+
+    return m_passes[pass].culled;
+}
+
+int GLRenderGraph::getPassNum() const
+{
+    return static_cast<int>(m_passes.size());
+}
+
+int GLRenderGraph::getCulledPassNum() const
+{
+    return static_cast<int>(std::count_if(m_passes.begin(), m_passes.end(),
+                                          [](const PassNode& pass) { return pass.culled; }));
+}
+
+int GLRenderGraph::getTransientTextureNum() const
+{
+    return static_cast<int>(std::count_if(m_textures.begin(), m_textures.end(),
+                                          [](const TextureNode& node) { return node.imported == nullptr; }));
+}
+
+int GLRenderGraph::getPhysicalTextureNum() const
+{
+    return static_cast<int>(m_physical_textures.size());
+}
+
+void GLRenderGraph::checkTextureHandle(int texture) const
+{
+    if (texture < 0 || texture >= static_cast<int>(m_textures.size()))
+    {
+        LOGE("error: invalid render graph texture: %d", texture);
+        throw std::invalid_argument("error: invalid render graph texture");
+    }
+}
+
+void GLRenderGraph::validate()
+{
+    for (TextureNode& node : m_textures)
+    {
+        node.writer = -1;
+        node.last_reader = -1;
+        node.physical = -1;
+    }
+
+    //writers are assigned in declaration order, i.e. reading a transient texture before it is written is detected here
+    for (int i = 0; i < static_cast<int>(m_passes.size()); ++i)
+    {
+        const PassNode& pass = m_passes[i];
+
+        if (pass.shader == nullptr || !pass.shader->isValid())
+        {
+            LOGE("error: invalid shader of render graph pass %s", pass.name.c_str());
+            throw std::invalid_argument("error: invalid shader of render graph pass");
+        }
+
+        if (pass.outputs.empty())
+        {
+            LOGE("error: render graph pass %s has no output", pass.name.c_str());
+            throw std::invalid_argument("error: render graph pass has no output");
+        }
+
+        for (const GLRenderGraphInput& input : pass.inputs)
+        {
+            this->checkTextureHandle(input.texture);
+
+            const TextureNode& node = m_textures[input.texture];
+            if (node.imported == nullptr && node.writer < 0)
+            {
+                LOGE("error: render graph pass %s reads %s before it is written", pass.name.c_str(), node.name.c_str());
+                throw std::invalid_argument("error: render graph pass reads a texture before it is written");
+            }
+
+            if (std::find(pass.outputs.begin(), pass.outputs.end(), input.texture) != pass.outputs.end())
+            {
+                LOGE("error: render graph pass %s reads & writes %s (feedback loop)", pass.name.c_str(), node.name.c_str());
+                throw std::invalid_argument("error: render graph pass reads & writes the same texture");
+            }
+        }
+
+        for (int output : pass.outputs)
+        {
+            this->checkTextureHandle(output);
+
+            TextureNode& node = m_textures[output];
+            if (node.writer >= 0)
+            {
+                LOGE("error: %s is written by both %s and %s", node.name.c_str(), m_passes[node.writer].name.c_str(), pass.name.c_str());
+                throw std::invalid_argument("error: render graph texture is written twice");
+            }
+
+            const TextureNode& first = m_textures[pass.outputs[0]];
+            if (node.width != first.width || node.height != first.height)
+            {
+                LOGE("error: outputs of render graph pass %s have different sizes", pass.name.c_str());
+                throw std::invalid_argument("error: outputs of render graph pass have different sizes");
+            }
+
+            node.writer = i;
+        }
+    }
+}
+
+void GLRenderGraph::cullPasses()
+{
+    //imported textures are observable outside the graph, i.e. always needed
+    std::vector<bool> needed(m_textures.size(), false);
+    for (size_t i = 0; i < m_textures.size(); ++i)
+        needed[i] = m_textures[i].is_output || m_textures[i].imported != nullptr;
+
+    //reverse declaration order, i.e. consumers are visited before producers
+    for (int i = static_cast<int>(m_passes.size()) - 1; i >= 0; --i)
+    {
+        PassNode& pass = m_passes[i];
+
+        pass.culled = std::none_of(pass.outputs.begin(), pass.outputs.end(),
+                                   [&needed](int output) { return needed[output]; });
+        if (pass.culled)
+            continue;
+
+        for (const GLRenderGraphInput& input : pass.inputs)
+        {
+            needed[input.texture] = true;
+
+            TextureNode& node = m_textures[input.texture];
+            node.last_reader = std::max(node.last_reader, i);
+        }
+    }
+}
+
+void GLRenderGraph::assignPhysicalTextures()
+{
+    //fbo wraps physical textures, destroy it first
+    for (PassNode& pass : m_passes)
+        pass.frame_buffer.destroy();
+
+    m_physical_textures.clear();
+
+    //physical textures whose lifetime has ended, reusable by later passes
+    std::vector<int> free_physicals;
+
+    for (int i = 0; i < static_cast<int>(m_passes.size()); ++i)
+    {
+        PassNode& pass = m_passes[i];
+        if (pass.culled)
+            continue;
+
+        std::vector<const GLTexture*> color_texs;
+
+        pass.render_pass = GLRenderPass();
+        pass.render_pass.color_actions.resize(pass.outputs.size());
+
+        for (size_t j = 0; j < pass.outputs.size(); ++j)
+        {
+            TextureNode& node = m_textures[pass.outputs[j]];
+
+            //full screen pass overwrites every pixel, previous contents are never needed
+            pass.render_pass.color_actions[j].load_action = GLLoadAction::DONT_CARE;
+
+            if (node.imported == nullptr)
+            {
+                auto iter = std::find_if(free_physicals.begin(), free_physicals.end(),
+                                         [this, &node](int physical)
+                                         {
+                                             const GLResourceKey& key = m_physical_textures[physical].getKey();
+                                             return key.width == node.width && key.height == node.height &&
+                                                    key.internal_format == node.internal_format;
+                                         });
+
+                if (iter != free_physicals.end())
+                {
+                    node.physical = *iter;
+                    free_physicals.erase(iter);
+                }
+                else
+                {
+                    m_physical_textures.push_back(m_pool->acquireTexture(node.width, node.height, node.internal_format));
+                    node.physical = static_cast<int>(m_physical_textures.size()) - 1;
+                }
+
+                //written but never read, e.g. unused MRT output of a kept pass
+                if (node.last_reader < 0 && !node.is_output)
+                    pass.render_pass.color_actions[j].store_action = GLStoreAction::DISCARD;
+            }
+
+            color_texs.push_back(&this->resolveTexture(pass.outputs[j]));
+        }
+
+        pass.frame_buffer.init(color_texs);
+
+        //lifetime ends at last reader (or writer if never read), physical texture can be reused from the next pass on
+        for (TextureNode& node : m_textures)
+        {
+            if (node.imported != nullptr || node.is_output || node.physical < 0)
+                continue;
+
+            if (std::max(node.writer, node.last_reader) == i)
+                free_physicals.push_back(node.physical);
+        }
+    }
+}
+
+GLTexture& GLRenderGraph::resolveTexture(int texture)
+{
+    TextureNode& node = m_textures[texture];
+
+    if (node.imported != nullptr)
+        return *node.imported;
+
+    if (node.physical < 0)
+    {
+        LOGE("error: render graph texture %s has no physical texture, i.e. its writer is culled", node.name.c_str());
+        throw std::runtime_error("error: render graph texture has no physical texture");
+    }
+
+    return *m_physical_textures[node.physical];
+}
+
+}//end of namespace luna
@@ -0,0 +1,174 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: declarative full screen pass graph, culls unused passes & aliases intermediate textures
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gl_include.h"
+
+#include "gl_texture.h"
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+#include "gl_resource_pool.h"
+
+namespace luna {
+
+//NOTE: typical usage for a chain of filters:
+//
+//    GLRenderGraph graph(&pool);
+//    int src  = graph.importTexture("src", src_tex);
+//    int dst  = graph.importTexture("dst", dst_tex);
+//    int blur = graph.createTexture("blur", w, h, GL_RGBA16F);
+//    graph.addPass("blur",    blur_shader,    {{"u_src", src}},                  {blur});
+//    graph.addPass("sharpen", sharpen_shader, {{"u_src", src}, {"u_blur", blur}}, {dst});
+//    graph.compile();   //once, or whenever the graph changes
+//    graph.execute();   //every frame
+//
+//    Transient textures are only alive from the pass writing them to the last pass reading them,
+//    transient textures with the same size & format and disjoint lifetimes share one physical texture,
+//    so peak memory is bounded by the widest point of the graph instead of the sum of all intermediates.
+//    Passes whose outputs are neither read by kept passes nor graph outputs are culled.
+//    Imported textures are never aliased, writing an imported texture makes it a graph output.
+//    Passes are executed in declaration order, i.e. a pass can only read textures written by former passes.
+//    "v_tex_coord" of a pass follows the FLIP_TEXCOORD state of its first input, i.e. mixed flipped inputs are not supported.
+
+struct GLRenderGraphInput
+{
+    std::string sampler_name; //sampler2D uniform of pass shader
+    int texture = -1;         //handle returned by createTexture/importTexture
+};
+
+class GLRenderGraph
+{
+public:
+
+    //transient textures are leased from pool if not null, otherwise from a pool owned by the graph
+    explicit GLRenderGraph(GLResourcePool* pool = nullptr);
+
+    ~GLRenderGraph() = default;
+
+    //disable copy
+    GLRenderGraph(const GLRenderGraph& rhs) = delete;
+    GLRenderGraph& operator = (const GLRenderGraph& rhs) = delete;
+
+    //disable move, leases keep a pointer to the owned pool
+    GLRenderGraph(GLRenderGraph&& rhs) = delete;
+    GLRenderGraph& operator = (GLRenderGraph&& rhs) = delete;
+
+    //-----------
+
+    //declare a transient texture, physical texture is assigned by compile(), contents are undefined before written
+    int createTexture(const std::string& name, int width, int height, GLint internal_format = GL_RGBA8);
+
+    //declare an external texture, e.g. source image or final target, texture must outlive the graph
+    int importTexture(const std::string& name, GLTexture& texture);
+
+    //keep passes contributing to a transient texture, e.g. to read it back after execute()
+    void markOutput(int texture);
+
+    //full screen pass, outputs are bound as color attachments 0..n-1 and must have the same size,
+    //set_uniforms is called after inputs are bound, shader must outlive the graph
+    int addPass(const std::string& name,
+                GLShader& shader,
+                const std::vector<GLRenderGraphInput>& inputs,
+                const std::vector<int>& outputs,
+                std::function<void(GLShader&)> set_uniforms = nullptr);
+
+    //validate, cull passes, compute lifetimes and assign physical textures & frame buffers
+    void compile();
+
+    //run kept passes in declaration order, compile() is called if necessary
+    void execute();
+
+    //remove all passes & textures, physical textures go back to pool
+    void reset();
+
+    //-----------
+
+    //physical texture of a handle, valid after compile()
+    GLTexture& getTexture(int texture);
+
+    bool isCompiled() const;
+
+    bool isPassCulled(int pass) const;
+
+    int getPassNum() const;
+
+    int getCulledPassNum() const;
+
+    int getTransientTextureNum() const;
+
+    //number of physical textures backing transient textures, <= getTransientTextureNum()
+    int getPhysicalTextureNum() const;
+
+private:
+
+    struct TextureNode
+    {
+        std::string name;
+
+        int width = 0;
+        int height = 0;
+        GLint internal_format = GL_RGBA8;
+
+        GLTexture* imported = nullptr;
+
+        bool is_output = false;
+
+        //assigned by compile()
+        int writer = -1;       //pass index
+        int last_reader = -1;  //pass index
+        int physical = -1;     //index of m_physical_textures
+    };
+
+    struct PassNode
+    {
+        std::string name;
+
+        GLShader* shader = nullptr;
+
+        std::vector<GLRenderGraphInput> inputs;
+        std::vector<int> outputs;
+
+        std::function<void(GLShader&)> set_uniforms;
+
+        //assigned by compile()
+        bool culled = false;
+        GLRenderPass render_pass;
+        GLFrameBuffer frame_buffer;
+    };
+
+    void checkTextureHandle(int texture) const;
+
+    void validate();
+
+    void cullPasses();
+
+    void assignPhysicalTextures();
+
+    GLTexture& resolveTexture(int texture);
+
+private:
+    GLResourcePool* m_pool = nullptr;
+    std::unique_ptr<GLResourcePool> m_own_pool; //declared before leases, i.e. destroyed after them
+
+    std::vector<TextureNode> m_textures;
+    std::vector<PassNode> m_passes;
+
+    std::vector<GLTextureLease> m_physical_textures;
+
+    GLFullScreenPass m_fullscreen_pass;
+
+    bool m_compiled = false;
+};
+
+}//end of namespace luna
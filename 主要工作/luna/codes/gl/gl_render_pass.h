@@ -0,0 +1,75 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl render pass descriptor (load/store actions)
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "gl_include.h"
+
+namespace luna {
+
+//NOTE: load/store actions mainly serve tile-based mobile GPUs (Mali, Adreno, PowerVR, Apple),
+//      DONT_CARE / DISCARD let the driver skip loading/storing tile memory from/to system memory.
+
+enum class GLLoadAction
+{
+    LOAD,       //!< keep previous contents
+    CLEAR,      //!< clear to clear value
+    DONT_CARE,  //!< previous contents are undefined, i.e. glInvalidateFramebuffer before rendering
+};
+
+enum class GLStoreAction
+{
+    STORE,      //!< keep rendered contents
+    DISCARD,    //!< rendered contents are not needed anymore, i.e. glInvalidateFramebuffer after rendering
+};
+
+struct GLColorAttachmentAction
+{
+    GLLoadAction load_action = GLLoadAction::CLEAR;
+    GLStoreAction store_action = GLStoreAction::STORE;
+
+    glm::vec4 clear_color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+};
+
+struct GLDepthAttachmentAction
+{
+    GLLoadAction load_action = GLLoadAction::CLEAR;
+    GLStoreAction store_action = GLStoreAction::DISCARD; //depth is rarely read back
+
+    float clear_depth = 1.0f;
+};
+
+struct GLStencilAttachmentAction
+{
+    GLLoadAction load_action = GLLoadAction::CLEAR;
+    GLStoreAction store_action = GLStoreAction::DISCARD; //stencil masks are rarely needed after the pass
+
+    int clear_stencil = 0;
+};
+
+struct GLRenderPass
+{
+    //action of i-th color attachment, default_color_action is used if i >= color_actions.size()
+    std::vector<GLColorAttachmentAction> color_actions;
+
+    GLColorAttachmentAction default_color_action;
+
+    GLDepthAttachmentAction depth_action;
+
+    GLStencilAttachmentAction stencil_action; //ignored if fbo has no stencil
+
+    const GLColorAttachmentAction& getColorAction(unsigned int index) const
+    {
+        return index < color_actions.size() ? color_actions[index] : default_color_action;
+    }
+};
+
+}//end of namespace luna
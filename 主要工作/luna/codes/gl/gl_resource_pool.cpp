@@ -0,0 +1,143 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: pool of transient textures & frame buffers keyed by size and format
+ * @version    : 1.0
+ */
+
+#include <algorithm>
+
+#include "core/log/log.h"
+
+#include "gl_resource_pool.h"
+
+namespace luna {
+
+GLResourcePool::GLResourcePool(int max_idle_frames)
+    : m_max_idle_frames(std::max(max_idle_frames, 0))
+{
+
+}
+
+template <typename Resource>
+std::unique_ptr<Resource> GLResourcePool::takeIdle(std::vector<IdleEntry<Resource>>& idle_entries, const GLResourceKey& key)
+{
+    //search backward, i.e. most recently used first (still hot in driver caches)
+    for (auto iter = idle_entries.rbegin(); iter != idle_entries.rend(); ++iter)
+    {
+        if (iter->key == key)
+        {
+            std::unique_ptr<Resource> resource = std::move(iter->resource);
+            idle_entries.erase(std::next(iter).base());
+            return resource;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename Resource>
+void GLResourcePool::evictIdle(std::vector<IdleEntry<Resource>>& idle_entries)
+{
+    idle_entries.erase(std::remove_if(idle_entries.begin(), idle_entries.end(),
+                                      [this](const IdleEntry<Resource>& entry)
+                                      {
+                                          return m_frame_index - entry.last_used_frame > static_cast<uint64_t>(m_max_idle_frames);
+                                      }),
+                       idle_entries.end());
+}
+
+GLTextureLease GLResourcePool::acquireTexture(int width, int height, GLint internal_format, unsigned int multi_sample)
+{
+    GLResourceKey key;
+    key.width = width;
+    key.height = height;
+    key.internal_format = internal_format;
+    key.multi_sample = multi_sample;
+
+    std::unique_ptr<GLTexture> texture = takeIdle(m_idle_textures, key);
+    if (!texture)
+    {
+        texture = std::make_unique<GLTexture>();
+        texture->allocate(width, height, internal_format, multi_sample);
+
+        ++m_created_num;
+    }
+
+    return GLTextureLease(this, key, std::move(texture));
+}
+
+GLFrameBufferLease GLResourcePool::acquireFrameBuffer(int width,
+                                                      int height,
+                                                      GLint color_internal_format,
+                                                      bool need_depth,
+                                                      unsigned int multi_sample,
+                                                      unsigned int color_attachment_num)
+{
+    GLResourceKey key;
+    key.width = width;
+    key.height = height;
+    key.internal_format = color_internal_format;
+    key.multi_sample = multi_sample;
+    key.need_depth = need_depth;
+    key.color_attachment_num = color_attachment_num;
+
+    std::unique_ptr<GLFrameBuffer> frame_buffer = takeIdle(m_idle_frame_buffers, key);
+    if (!frame_buffer)
+    {
+        //completeness is checked once here, never for a recycled frame buffer
+        frame_buffer = std::make_unique<GLFrameBuffer>();
+        frame_buffer->init(width, height, need_depth, true, color_internal_format, multi_sample, color_attachment_num);
+
+        ++m_created_num;
+    }
+
+    return GLFrameBufferLease(this, key, std::move(frame_buffer));
+}
+
+void GLResourcePool::recycle(const GLResourceKey& key, std::unique_ptr<GLTexture> texture)
+{
+    //reset per-use state, filter & wrap mode are kept
+    if (texture->isBGRStorage())
+        texture->setBGRStorage(false);
+
+    texture->setVerticalFlipped(false);
+
+    m_idle_textures.push_back({ key, std::move(texture), m_frame_index });
+}
+
+void GLResourcePool::recycle(const GLResourceKey& key, std::unique_ptr<GLFrameBuffer> frame_buffer)
+{
+    m_idle_frame_buffers.push_back({ key, std::move(frame_buffer), m_frame_index });
+}
+
+void GLResourcePool::nextFrame()
+{
+    ++m_frame_index;
+
+    this->evictIdle(m_idle_textures);
+    this->evictIdle(m_idle_frame_buffers);
+}
+
+void GLResourcePool::clear()
+{
+    m_idle_textures.clear();
+    m_idle_frame_buffers.clear();
+}
+
+int GLResourcePool::getIdleTextureNum() const
+{
+    return static_cast<int>(m_idle_textures.size());
+}
+
+int GLResourcePool::getIdleFrameBufferNum() const
+{
+    return static_cast<int>(m_idle_frame_buffers.size());
+}
+
+uint64_t GLResourcePool::getCreatedNum() const
+{
+    return m_created_num;
+}
+
+}//end of namespace luna
@@ -0,0 +1,232 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: pool of transient textures & frame buffers keyed by size and format
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gl_include.h"
+
+#include "gl_texture.h"
+#include "gl_framebuffer.h"
+
+namespace luna {
+
+//NOTE: typical usage for multi-pass filters:
+//
+//    GLFrameBufferLease tmp = pool.acquireFrameBuffer(w, h, GL_RGBA16F);
+//    tmp->beginRenderPass(render_pass);   //contents are undefined, use CLEAR or DONT_CARE load action
+//    ...
+//    //tmp goes back to pool on destruction (or tmp.release())
+//
+//    pool.nextFrame();                    //once per frame, idle entries not used for max_idle_frames are destroyed
+//
+//    All methods must be called on the thread owning the GL context, leases must not outlive the pool.
+
+struct GLResourceKey
+{
+    int width = 0;
+    int height = 0;
+
+    GLint internal_format = GL_RGBA8;
+
+    unsigned int multi_sample = 1;
+
+    bool need_depth = false;               //frame buffer only
+    unsigned int color_attachment_num = 1; //frame buffer only
+
+    bool operator == (const GLResourceKey& rhs) const
+    {
+        return width == rhs.width && height == rhs.height && internal_format == rhs.internal_format &&
+               multi_sample == rhs.multi_sample && need_depth == rhs.need_depth &&
+               color_attachment_num == rhs.color_attachment_num;
+    }
+
+    bool operator != (const GLResourceKey& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+class GLResourcePool;
+
+//leased resource, goes back to pool on release() or destruction
+template <typename Resource>
+class GLLease
+{
+public:
+
+    GLLease() = default;
+
+    ~GLLease()
+    {
+        this->release();
+    }
+
+    //disable copy
+    GLLease(const GLLease& rhs) = delete;
+    GLLease& operator = (const GLLease& rhs) = delete;
+
+    //enable move
+    GLLease(GLLease&& rhs) noexcept = default;
+
+    GLLease& operator = (GLLease&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            this->release();
+
+            m_pool = rhs.m_pool;
+            m_key = rhs.m_key;
+            m_resource = std::move(rhs.m_resource);
+        }
+        return *this;
+    }
+
+    //-----------
+
+    void release();
+
+    bool isValid() const
+    {
+        return m_resource != nullptr;
+    }
+
+    explicit operator bool () const
+    {
+        return this->isValid();
+    }
+
+    Resource* get() const
+    {
+        return m_resource.get();
+    }
+
+    Resource* operator -> () const
+    {
+        return m_resource.get();
+    }
+
+    Resource& operator * () const
+    {
+        return *m_resource;
+    }
+
+    const GLResourceKey& getKey() const
+    {
+        return m_key;
+    }
+
+private:
+    friend class GLResourcePool;
+
+    GLLease(GLResourcePool* pool, const GLResourceKey& key, std::unique_ptr<Resource> resource)
+        : m_pool(pool), m_key(key), m_resource(std::move(resource))
+    {
+
+    }
+
+private:
+    GLResourcePool* m_pool = nullptr;
+
+    GLResourceKey m_key;
+
+    std::unique_ptr<Resource> m_resource;
+};
+
+using GLTextureLease = GLLease<GLTexture>;
+using GLFrameBufferLease = GLLease<GLFrameBuffer>;
+
+class GLResourcePool
+{
+public:
+
+    explicit GLResourcePool(int max_idle_frames = 3);
+
+    ~GLResourcePool() = default;
+
+    //disable copy
+    GLResourcePool(const GLResourcePool& rhs) = delete;
+    GLResourcePool& operator = (const GLResourcePool& rhs) = delete;
+
+    //disable move, leases keep a pointer to the pool
+    GLResourcePool(GLResourcePool&& rhs) = delete;
+    GLResourcePool& operator = (GLResourcePool&& rhs) = delete;
+
+    //-----------
+
+    //contents of a leased resource are undefined
+    GLTextureLease acquireTexture(int width,
+                                  int height,
+                                  GLint internal_format = GL_RGBA8,
+                                  unsigned int multi_sample = 1);
+
+    GLFrameBufferLease acquireFrameBuffer(int width,
+                                          int height,
+                                          GLint color_internal_format = GL_RGBA8,
+                                          bool need_depth = false,
+                                          unsigned int multi_sample = 1,
+                                          unsigned int color_attachment_num = 1);
+
+    //advance frame counter and destroy idle entries not used for more than max_idle_frames
+    void nextFrame();
+
+    //destroy all idle entries, e.g. before destroying the GL context
+    void clear();
+
+    int getIdleTextureNum() const;
+
+    int getIdleFrameBufferNum() const;
+
+    //number of GL objects created by the pool, for profiling, should stay flat in steady state
+    uint64_t getCreatedNum() const;
+
+private:
+    template <typename Resource>
+    friend class GLLease;
+
+    void recycle(const GLResourceKey& key, std::unique_ptr<GLTexture> texture);
+
+    void recycle(const GLResourceKey& key, std::unique_ptr<GLFrameBuffer> frame_buffer);
+
+    template <typename Resource>
+    struct IdleEntry
+    {
+        GLResourceKey key;
+        std::unique_ptr<Resource> resource;
+        uint64_t last_used_frame = 0;
+    };
+
+    template <typename Resource>
+    static std::unique_ptr<Resource> takeIdle(std::vector<IdleEntry<Resource>>& idle_entries, const GLResourceKey& key);
+
+    template <typename Resource>
+    void evictIdle(std::vector<IdleEntry<Resource>>& idle_entries);
+
+private:
+    std::vector<IdleEntry<GLTexture>> m_idle_textures;
+    std::vector<IdleEntry<GLFrameBuffer>> m_idle_frame_buffers;
+
+    uint64_t m_frame_index = 0;
+
+    int m_max_idle_frames = 3;
+
+    uint64_t m_created_num = 0;
+};
+
+template <typename Resource>
+void GLLease<Resource>::release()
+{
+    if (m_pool != nullptr && m_resource != nullptr)
+        m_pool->recycle(m_key, std::move(m_resource));
+
+    m_resource.reset();
+}
+
+}//end of namespace luna
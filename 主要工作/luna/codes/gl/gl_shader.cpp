@@ -20,6 +20,9 @@
 #include "gl_utility.h"
 
 #include "gl_texture.h"
+#include "gl_texture_array.h"
+#include "gl_texture_cubemap.h"
+#include "gl_texture_3d.h"
 
 #include "gl_shader.h"
 
@@ -429,7 +432,7 @@ bool GLShader::setMat4(const std::string & name, const glm::mat4 & val)
     return openGLSetShaderMat4(this->m_program, name, val);
 }
 
-bool GLShader::setTexture(const std::string& name, int tex_id)
+int GLShader::getTextureUnit(const std::string& name)
 {
     int tex_unit = -1;
 
@@ -445,6 +448,13 @@ bool GLShader::setTexture(const std::string& name, int tex_id)
         m_tex_map[name] = tex_unit;
     }
 
+    return tex_unit;
+}
+
+bool GLShader::setTexture(const std::string& name, int tex_id)
+{
+    const int tex_unit = this->getTextureUnit(name);
+
     glActiveTexture(tex_unit);
     glBindTexture(GL_TEXTURE_2D, tex_id);
 
@@ -453,19 +463,40 @@ bool GLShader::setTexture(const std::string& name, int tex_id)
 
 bool GLShader::setTexture(const std::string& name, const GLTexture& tex)
 {
-    int tex_unit = -1;
+    //lazy mip generation, i.e. only textures sampled after level 0 changed pay for it
+    tex.updateMipmaps();
 
-    if (m_tex_map.find(name) != m_tex_map.end())
-    {
-        tex_unit = m_tex_map[name];
-    }
-    else
-    {
-        tex_unit = GL_TEXTURE0 + m_cur_tex_offset;
-        ++m_cur_tex_offset;
+    const int tex_unit = this->getTextureUnit(name);
 
-        m_tex_map[name] = tex_unit;
-    }
+    glActiveTexture(tex_unit);
+    tex.bind();
+
+    return openGLSetShaderInt(this->m_program, name, tex_unit - GL_TEXTURE0);
+}
+
+bool GLShader::setTexture(const std::string& name, const GLTextureArray& tex)
+{
+    const int tex_unit = this->getTextureUnit(name);
+
+    glActiveTexture(tex_unit);
+    tex.bind();
+
+    return openGLSetShaderInt(this->m_program, name, tex_unit - GL_TEXTURE0);
+}
+
+bool GLShader::setTexture(const std::string& name, const GLTextureCubeMap& tex)
+{
+    const int tex_unit = this->getTextureUnit(name);
+
+    glActiveTexture(tex_unit);
+    tex.bind();
+
+    return openGLSetShaderInt(this->m_program, name, tex_unit - GL_TEXTURE0);
+}
+
+bool GLShader::setTexture(const std::string& name, const GLTexture3D& tex)
+{
+    const int tex_unit = this->getTextureUnit(name);
 
     glActiveTexture(tex_unit);
     tex.bind();
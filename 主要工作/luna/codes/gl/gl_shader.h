@@ -18,6 +18,9 @@
 namespace luna {
 
 class GLTexture;
+class GLTextureArray;
+class GLTextureCubeMap;
+class GLTexture3D;
 
 class GLShader
 {
@@ -99,6 +102,12 @@ public:
 
     bool setTexture(const std::string & name, const GLTexture& tex);
 
+    bool setTexture(const std::string & name, const GLTextureArray& tex); //sampler2DArray
+
+    bool setTexture(const std::string & name, const GLTextureCubeMap& tex); //samplerCube
+
+    bool setTexture(const std::string & name, const GLTexture3D& tex); //sampler3D
+
     bool setAttribLocation(const std::string & name, int loc);
 
     int getAttribLocation(const std::string & name) const;
@@ -112,6 +121,9 @@ public:
     void enableAutoReloadFromFile(bool enable); //enable auto reload if created from file, for hot reload
     void setAutoReloadCallback(const std::function<void()>& callback); //set callback for auto reload
 
+private:
+    int getTextureUnit(const std::string & name); //GL_TEXTURE0 + i, assigned on first use of name
+
 private:
     unsigned int m_program = 0;
 
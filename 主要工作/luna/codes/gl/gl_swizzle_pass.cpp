@@ -0,0 +1,104 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: swap red and blue channels on GPU, i.e. RGB <-> BGR without cv::cvtColor
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_render_pass.h"
+
+#include "gl_swizzle_pass.h"
+
+namespace luna {
+
+static const char* SWIZZLE_FRAGMENT_SHADER = R"(
+precision highp float;
+
+uniform sampler2D u_tex_src;
+uniform bool u_swap_red_blue;
+uniform bool u_vertical_flip;
+
+out vec4 frag_color;
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    if (u_vertical_flip)
+        p.y = textureSize(u_tex_src, 0).y - 1 - p.y;
+
+    vec4 color = texelFetch(u_tex_src, p, 0);
+    frag_color = u_swap_red_blue ? color.bgra : color;
+}
+)";
+
+bool GLSwizzlePass::apply(const GLTexture& src, GLFrameBuffer& dst, bool swap_red_blue, bool vertical_flip)
+{
+    if (!src.isValid())
+    {
+        LOGE("error: invalid src texture");
+        throw std::invalid_argument("error: invalid src texture");
+        return false;
+    }
+
+    if (src.getMultiSample() > 1)
+    {
+        LOGE("error: multi-sample texture can not be swizzled, resolve it first");
+        throw std::invalid_argument("error: multi-sample texture can not be swizzled");
+        return false;
+    }
+
+    if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight())
+    {
+        LOGE("error: size not match, src: %d x %d, dst: %d x %d", src.getWidth(), src.getHeight(), dst.getWidth(), dst.getHeight());
+        throw std::invalid_argument("error: size not match");
+        return false;
+    }
+
+    if (!m_shader.isValid())
+        m_shader.createFromString(GLFullScreenPass::getVertexShaderSource(), SWIZZLE_FRAGMENT_SHADER);
+
+    //every texel is overwritten
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::DONT_CARE;
+
+    dst.beginRenderPass(render_pass);
+
+    m_shader.use();
+    m_shader.setTexture("u_tex_src", src);
+    m_shader.setBool("u_swap_red_blue", swap_red_blue);
+    //rows of FLIP_TEXCOORD src are already upside down
+    m_shader.setBool("u_vertical_flip", vertical_flip != src.isVerticalFlipped());
+
+    m_fullscreen_pass.draw();
+
+    m_shader.unUse();
+
+    dst.endRenderPass();
+
+    return true;
+}
+
+bool GLSwizzlePass::read(const GLTexture& src, unsigned char* data, GLenum format, bool swap_red_blue, bool vertical_flip)
+{
+    if (format != GL_RGB && format != GL_RGBA)
+    {
+        LOGE("error: unsupported format to swizzle");
+        throw std::invalid_argument("error: unsupported format to swizzle");
+        return false;
+    }
+
+    if (m_fbo.getWidth() != src.getWidth() || m_fbo.getHeight() != src.getHeight())
+        m_fbo.init(src.getWidth(), src.getHeight());
+
+    this->apply(src, m_fbo, swap_red_blue, vertical_flip);
+
+    return m_fbo.read(data, format);
+}
+
+}//end of namespace luna
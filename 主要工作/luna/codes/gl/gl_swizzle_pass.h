@@ -0,0 +1,55 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: swap red and blue channels on GPU, i.e. RGB <-> BGR without cv::cvtColor
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "gl_include.h"
+
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+
+namespace luna {
+
+class GLTexture;
+
+//NOTE: desktop opengl swizzles during transfer via GL_BGR/GL_BGRA client format,
+//      OpenGLES has no GL_BGR/GL_BGRA, so the swap is done by a texel-exact copy pass before readback.
+
+class GLSwizzlePass
+{
+public:
+
+    GLSwizzlePass() = default;
+
+    ~GLSwizzlePass() = default;
+
+    //disable copy
+    GLSwizzlePass(const GLSwizzlePass& rhs) = delete;
+    GLSwizzlePass& operator = (const GLSwizzlePass& rhs) = delete;
+
+    //enable move
+    GLSwizzlePass(GLSwizzlePass&& rhs) noexcept = default;
+    GLSwizzlePass& operator = (GLSwizzlePass&& rhs) noexcept = default;
+
+    //-----------
+
+    //copy src into dst (same size), red and blue are swapped if swap_red_blue, rows are reversed if vertical_flip
+    //NOTE: src is sampled, i.e. texture swizzle & FLIP_TEXCOORD (isVerticalFlipped) of src are honored
+    bool apply(const GLTexture& src, GLFrameBuffer& dst, bool swap_red_blue = true, bool vertical_flip = false);
+
+    //apply into an internal RGBA8 target and read back with format (GL_RGB or GL_RGBA)
+    bool read(const GLTexture& src, unsigned char* data, GLenum format = GL_RGBA, bool swap_red_blue = true, bool vertical_flip = false);
+
+private:
+    GLShader m_shader;
+    GLFullScreenPass m_fullscreen_pass;
+
+    GLFrameBuffer m_fbo;
+};
+
+}//end of namespace luna
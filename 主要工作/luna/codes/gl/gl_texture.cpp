@@ -5,6 +5,9 @@
  * @version    : 1.0
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -16,7 +19,12 @@
 #include "core/log/log.h"
 
 #include "gl_utility.h"
+#include "gl_pixel_convert.h"
 #include "gl_framebuffer.h"
+#include "gl_swizzle_pass.h"
+#include "gl_copy_engine.h"
+#include "gl_mip_generator.h"
+#include "gl_context_resources.h"
 
 #include "gl_texture.h"
 
@@ -149,7 +157,9 @@ bool GLTexture::init(const std::string& image_file, bool vertical_flip, unsigned
     //destroy if necessary
     this->destroy();
 
-    stbi_set_flip_vertically_on_load(vertical_flip);
+    //FLIP_TEXCOORD: keep file row order, mark as flipped instead
+    const bool flip_pixels = vertical_flip && m_flip_policy == FlipPolicy::FLIP_PIXELS;
+    stbi_set_flip_vertically_on_load(flip_pixels);
 
     int channel_num = 0;
     unsigned char* data = stbi_load(image_file.c_str(), &m_width, &m_height, &channel_num, 0);
@@ -186,6 +196,8 @@ bool GLTexture::init(const std::string& image_file, bool vertical_flip, unsigned
 
     stbi_image_free(data);
 
+    m_vertical_flipped = vertical_flip && !flip_pixels;
+
     return true;
 }
 
@@ -207,72 +219,134 @@ bool GLTexture::init(const cv::Mat& img, GLenum format, bool vertical_flip, unsi
     return true;
 }
 
-template <typename Scale>
-bool GLTexture::updateTextureData(int width, int height, GLenum format, const Scale* data)
+bool GLTexture::allocate(int width, int height, GLint internal_format, unsigned int multi_sample, int mip_levels)
 {
-    if (m_tex_id == 0)
-    {
-        LOGE("error: invalid texture id: %d", m_tex_id);
-        throw std::invalid_argument("error: invalid texture id");
-        return false;
-    }
+    //destroy if necessary
+    this->destroy();
 
-    m_width = width;
-    m_height = height;
+    this->setupTexture(multi_sample);
 
-    //for compatibility
-    if (format == GL_LUMINANCE)
-        format = GL_RED;
+    if (mip_levels != KEEP_MIP_LEVELS)
+        m_requested_mip_levels = mip_levels;
 
-    this->bind();
+    this->allocateStorage(width, height, getSizedInternalFormat(internal_format));
+    m_explicit_format = true;
 
-    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    return true;
+}
 
-    GLint internal_format = this->getInternalFormat(format, std::is_same_v<Scale, float>);
+void GLTexture::allocateStorage(int width, int height, GLint internal_format)
+{
+    //storage of a wrapped texture belongs to its owner, i.e. it is never (re)specified here
+    if (!m_own_texture)
+    {
+        LOGE("error: can not allocate storage of wrapped texture (id: %u), size: %d x %d", m_tex_id, width, height);
+        throw std::invalid_argument("error: can not allocate storage of wrapped texture");
+    }
 
-    if constexpr (std::is_same_v<Scale, unsigned char>)
+    //NOTE: storage allocated by glTexStorage2D is immutable, i.e. can not be re-specified,
+    //      so a new texture object is created if storage already exists (texture id changes!)
+    if (m_internal_format != 0)
     {
-        if (m_multi_sample > 1)
-        {
-#if __IOS__
-            //IOS don't support multi-sample texture
-            assert(false);
-#elif __ANDROID__
-            if (format == GL_DEPTH_COMPONENT)
-                internal_format = GL_DEPTH_COMPONENT24; //special case for multi-sample depth texture
+        GLint params[4] = { GL_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE };
 
-            glVerify(glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample, internal_format, m_width, m_height, GL_TRUE));
-#else
-            glVerify(glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample,
-                                             internal_format, m_width, m_height, GL_TRUE));
-#endif
+        if (m_multi_sample <= 1)
+        {
+            glBindTexture(GL_TEXTURE_2D, m_tex_id);
+            glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &params[0]);
+            glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &params[1]);
+            glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &params[2]);
+            glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &params[3]);
         }
-        else
+
+        glVerify(glDeleteTextures(1, &m_tex_id));
+        m_tex_id = 0;
+
+        this->setupTexture(m_multi_sample);
+
+        if (m_multi_sample <= 1)
         {
-            if (format == GL_DEPTH_COMPONENT)
-                glVerify(glTexImage2D(GL_TEXTURE_2D, 0, internal_format, m_width, m_height, 0, format, GL_UNSIGNED_INT, data));
-            else
-                glVerify(glTexImage2D(GL_TEXTURE_2D, 0, internal_format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data));
+            this->setFilter(params[0], params[1]);
+            this->setWrapMode(params[2], params[3]);
         }
     }
-    else if constexpr (std::is_same_v<Scale, float>)
+
+    m_width = width;
+    m_height = height;
+    m_internal_format = internal_format;
+
+    //mip_levels <= 0 means full mip chain
+    const int full_mip_levels = 1 + static_cast<int>(std::floor(std::log2(std::max(std::max(width, height), 1))));
+    m_mip_levels = (m_requested_mip_levels <= 0) ? full_mip_levels : std::min(m_requested_mip_levels, full_mip_levels);
+    m_mipmaps_dirty = false;
+
+    this->bind();
+
+    if (m_multi_sample > 1)
     {
-        if (m_multi_sample > 1)
-        {
+        m_mip_levels = 1;
+
 #if __IOS__
-            //IOS don't support multi-sample texture
-            assert(false);
+        //IOS don't support multi-sample texture
+        assert(false);
 #elif __ANDROID__
-            glVerify(glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample, internal_format, m_width, m_height, GL_TRUE));
+        glVerify(glTexStorage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample, internal_format, m_width, m_height, GL_TRUE));
 #else
-            glVerify(glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample,
-                                             internal_format, m_width, m_height, GL_TRUE));
+        glVerify(glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_multi_sample,
+                                         internal_format, m_width, m_height, GL_TRUE));
 #endif
-        }
-        else
+    }
+    else
+    {
+#if __MACOS__
+        //NOTE: macOS only supports OpenGL 4.1, glTexStorage2D (4.2) is not available,
+        //      fallback to allocate all mip levels once by glTexImage2D
+        GLenum format = GL_RGBA;
+        GLenum type = GL_UNSIGNED_BYTE;
+        getFormatAndType(internal_format, format, type);
+
+        for (int level = 0; level < m_mip_levels; ++level)
         {
-            glVerify(glTexImage2D(GL_TEXTURE_2D, 0, internal_format, m_width, m_height, 0, format, GL_FLOAT, data));
+            int level_width = std::max(m_width >> level, 1);
+            int level_height = std::max(m_height >> level, 1);
+            glVerify(glTexImage2D(GL_TEXTURE_2D, level, internal_format, level_width, level_height, 0, format, type, nullptr));
         }
+#else
+        glVerify(glTexStorage2D(GL_TEXTURE_2D, m_mip_levels, internal_format, m_width, m_height));
+#endif
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_mip_levels - 1);
+
+        //default GL_LINEAR would never sample the other levels
+        GLint min_filter = GL_LINEAR;
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &min_filter);
+        if (m_mip_levels > 1 && min_filter == GL_LINEAR)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+}
+
+template <typename Scale>
+bool GLTexture::updateTextureData(int width, int height, GLenum format, const Scale* data)
+{
+    if (m_tex_id == 0)
+    {
+        LOGE("error: invalid texture id: %d", m_tex_id);
+        throw std::invalid_argument("error: invalid texture id");
+        return false;
+    }
+
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    GLenum type = GL_UNSIGNED_BYTE;
+
+    if constexpr (std::is_same_v<Scale, unsigned char>)
+    {
+        type = (format == GL_DEPTH_COMPONENT) ? GL_UNSIGNED_INT : GL_UNSIGNED_BYTE;
+    }
+    else if constexpr (std::is_same_v<Scale, float>)
+    {
+        type = GL_FLOAT;
     }
     else
     {
@@ -281,6 +355,67 @@ bool GLTexture::updateTextureData(int width, int height, GLenum format, const Sc
         return false;
     }
 
+    GLint internal_format = getSizedInternalFormat(this->getInternalFormat(format, std::is_same_v<Scale, float>));
+
+    //keep explicitly allocated storage (e.g. GL_RGBA16F) as long as data can be converted into it
+    if (m_internal_format != 0 && m_internal_format != internal_format)
+    {
+        if (isUploadCompatible(m_internal_format, format, std::is_same_v<Scale, float>))
+        {
+            internal_format = m_internal_format;
+        }
+        else if (m_explicit_format)
+        {
+            //never replace the format chosen by allocate() behind the caller's back (texture id would change as well)
+            LOGE("error: data (format: 0x%x) can not be uploaded into allocated storage (internal format: 0x%x)", format, m_internal_format);
+            throw std::invalid_argument("error: data can not be uploaded into allocated storage");
+            return false;
+        }
+    }
+
+    //only (re)allocate storage when size or format changes, i.e. per-frame update goes to glTexSubImage2D
+    bool storage_match = (m_width == width && m_height == height);
+    if (m_own_texture)
+        storage_match = storage_match && (m_internal_format == internal_format);
+
+    if (!storage_match)
+        this->allocateStorage(width, height, internal_format);
+
+    //BGR(A) is uploaded as RGB(A) without any conversion, red and blue are swapped back by texture swizzle
+    const GLenum client_format = format;
+    const bool bgr_storage = (format == GL_BGR || format == GL_BGRA);
+    format = getUploadFormat(format);
+
+    //texture object is re-created when storage is reallocated, i.e. swizzle state is lost
+    if (!storage_match || bgr_storage != m_bgr_storage)
+        this->setBGRStorage(bgr_storage);
+
+    //multi-sample texture can not be updated from client memory
+    //data == nullptr means only allocate storage, contents are undefined
+    if (m_multi_sample > 1 || data == nullptr)
+        return true;
+
+    //half-float storage: convert on CPU while staging, i.e. half of the GL_FLOAT upload traffic
+    if constexpr (std::is_same_v<Scale, float>)
+    {
+        GLenum storage_format = GL_RGBA;
+        GLenum storage_type = GL_FLOAT;
+        if (queryFormatAndType(m_internal_format, storage_format, storage_type) && storage_type == GL_HALF_FLOAT)
+        {
+            //caller's format, i.e. staging keeps the BGR swizzle set up above
+            const cv::Mat img(height, width, CV_32FC(getChannelNum(format)), const_cast<float*>(data));
+            return this->updateStaged(img, client_format, false);
+        }
+    }
+
+    this->bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    glVerify(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, format, type, data));
+
+    m_mipmaps_dirty = true;
+
     return true;
 }
 
@@ -298,23 +433,274 @@ bool GLTexture::update(const cv::Mat& img, GLenum format, bool vertical_flip)
 {
     checkChannelNum(img, format);
 
-    if(vertical_flip)
+    if (vertical_flip && m_flip_policy == FlipPolicy::FLIP_PIXELS)
     {
-        cv::Mat flip_img;
-        cv::flip(img, flip_img, 0);
+        bool succ = this->updateStaged(img, format, true);
+        m_vertical_flipped = false;
+        return succ;
+    }
+
+    bool succ = false;
 
-        if (flip_img.depth() == CV_32F)
-            return this->update(flip_img.cols, flip_img.rows, format, flip_img.ptr<float>());
+    if (img.isContinuous())
+    {
+        if (img.depth() == CV_32F)
+            succ = this->update(img.cols, img.rows, format, img.ptr<float>());
         else
-            return this->update(flip_img.cols, flip_img.rows, format, flip_img.data);
+            succ = this->update(img.cols, img.rows, format, img.data);
     }
     else
     {
-        if (img.depth() == CV_32F)
-            return this->update(img.cols, img.rows, format, img.ptr<float>());
-        else
-            return this->update(img.cols, img.rows, format, img.data);
+        //e.g. ROI of a larger frame, rows are strided by img.step
+        this->updateStorage(img, format);
+        succ = this->updateRegion(0, 0, img.cols, img.rows, img, format);
     }
+
+    m_vertical_flipped = vertical_flip;
+
+    return succ;
+}
+
+void GLTexture::updateStorage(const cv::Mat& img, GLenum format)
+{
+    //data == nullptr means allocate storage & setup swizzle only
+    if (img.depth() == CV_32F)
+        this->updateTextureData(img.cols, img.rows, format, static_cast<const float*>(nullptr));
+    else
+        this->updateTextureData(img.cols, img.rows, format, static_cast<const unsigned char*>(nullptr));
+}
+
+bool GLTexture::updateStaged(const cv::Mat& img, GLenum format, bool vertical_flip)
+{
+    const bool use_float = (img.depth() == CV_32F);
+
+    this->updateStorage(img, format);
+
+    if (m_multi_sample > 1)
+        return true;
+
+    GLenum storage_format = GL_RGBA;
+    GLenum storage_type = GL_UNSIGNED_BYTE;
+    const bool to_half = use_float && queryFormatAndType(m_internal_format, storage_format, storage_type) && storage_type == GL_HALF_FLOAT;
+
+    const int element_num = img.cols * img.channels();
+    const int src_row_bytes = static_cast<int>(img.cols * img.elemSize());
+    const int dst_row_bytes = to_half ? element_num * static_cast<int>(sizeof(uint16_t)) : src_row_bytes;
+    const int size = dst_row_bytes * img.rows;
+
+    if (!m_staging_pbo)
+        m_staging_pbo = std::make_unique<GLPixelBuffer>(GL_PIXEL_UNPACK_BUFFER);
+
+    //orphan previous storage, i.e. never wait for the previous upload still sourcing from it
+    m_staging_pbo->update(nullptr, size, GL_STREAM_DRAW);
+
+    auto* dst = static_cast<unsigned char*>(m_staging_pbo->map(0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (dst == nullptr)
+    {
+        LOGE("error: can not map staging buffer");
+        throw std::runtime_error("error: can not map staging buffer");
+        return false;
+    }
+
+    //flip & conversion are folded into the only copy, rows of a non-continuous img are handled as well
+    if (to_half)
+        convertImage(img.data, img.step[0], dst, dst_row_bytes, img.cols, img.rows, img.channels(), PixelConversion::FLOAT_TO_HALF, vertical_flip);
+    else
+        convertImage(img.data, img.step[0], dst, dst_row_bytes, img.cols, img.rows, static_cast<int>(img.elemSize()), PixelConversion::COPY, vertical_flip);
+
+    m_staging_pbo->unmap();
+
+    GLenum type = GL_UNSIGNED_BYTE;
+    if (to_half)
+        type = GL_HALF_FLOAT;
+    else if (use_float)
+        type = GL_FLOAT;
+    else if (format == GL_DEPTH_COMPONENT)
+        type = GL_UNSIGNED_INT;
+
+    m_staging_pbo->bind();
+    this->bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    //data pointer is an offset into the bound GL_PIXEL_UNPACK_BUFFER
+    glVerify(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, getUploadFormat(format), type, nullptr));
+
+    this->unbind();
+    m_staging_pbo->unbind();
+
+    m_mipmaps_dirty = true;
+
+    return true;
+}
+
+template <typename Scale>
+bool GLTexture::updateSubImage(int x, int y, int width, int height, GLenum format, const Scale* data,
+                               int row_length, int skip_pixels, int skip_rows, int level)
+{
+    if (m_tex_id == 0)
+    {
+        LOGE("error: invalid texture id: %d", m_tex_id);
+        throw std::invalid_argument("error: invalid texture id");
+        return false;
+    }
+
+    if (m_multi_sample > 1)
+    {
+        LOGE("error: multi-sample texture can not be updated from client memory");
+        throw std::invalid_argument("error: multi-sample texture can not be updated from client memory");
+        return false;
+    }
+
+    if (level < 0 || level >= m_mip_levels)
+    {
+        LOGE("error: invalid mip level %d of %d levels", level, m_mip_levels);
+        throw std::invalid_argument("error: invalid mip level");
+        return false;
+    }
+
+    const int level_width = this->getLevelWidth(level);
+    const int level_height = this->getLevelHeight(level);
+
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > level_width || y + height > level_height)
+    {
+        LOGE("error: invalid region (%d, %d, %d, %d) of texture level %d x %d", x, y, width, height, level_width, level_height);
+        throw std::invalid_argument("error: invalid region");
+        return false;
+    }
+
+    //swizzle applies to the whole texture, i.e. channel order of region must match storage
+    const bool is_bgr = (format == GL_BGR || format == GL_BGRA);
+    const bool is_rgb = (format == GL_RGB || format == GL_RGBA);
+    if ((is_bgr && !m_bgr_storage) || (is_rgb && m_bgr_storage))
+    {
+        LOGE("error: channel order of region does not match texture storage");
+        throw std::invalid_argument("error: channel order of region does not match texture storage");
+        return false;
+    }
+
+    GLenum type = GL_UNSIGNED_BYTE;
+
+    if constexpr (std::is_same_v<Scale, unsigned char>)
+    {
+        type = (format == GL_DEPTH_COMPONENT) ? GL_UNSIGNED_INT : GL_UNSIGNED_BYTE;
+    }
+    else if constexpr (std::is_same_v<Scale, float>)
+    {
+        type = GL_FLOAT;
+    }
+    else
+    {
+        LOGE("error: unsupported data type");
+        throw std::invalid_argument("error: unsupported data type");
+        return false;
+    }
+
+    this->bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    glVerify(glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length));
+    glVerify(glPixelStorei(GL_UNPACK_SKIP_PIXELS, skip_pixels));
+    glVerify(glPixelStorei(GL_UNPACK_SKIP_ROWS, skip_rows));
+
+    glVerify(glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, getUploadFormat(format), type, data));
+
+    //restore defaults, other uploads assume tightly packed rows
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+
+    this->unbind();
+
+    if (level == 0)
+        m_mipmaps_dirty = true;
+
+    return true;
+}
+
+bool GLTexture::updateRegion(int x, int y, int width, int height, const cv::Mat& img, GLenum format)
+{
+    checkChannelNum(img, format);
+
+    if (width > img.cols || height > img.rows)
+    {
+        LOGE("error: region %d x %d is larger than image %d x %d", width, height, img.cols, img.rows);
+        throw std::invalid_argument("error: region is larger than image");
+        return false;
+    }
+
+    const int row_length = getRowLength(img);
+
+    //NOTE: rare case, step is not a multiple of pixel size, i.e. can not be expressed by GL_UNPACK_ROW_LENGTH
+    if (row_length < 0)
+        return this->updateRegion(x, y, width, height, img.clone(), format);
+
+    if (img.depth() == CV_32F)
+        return this->updateSubImage(x, y, width, height, format, img.ptr<float>(), row_length);
+    else
+        return this->updateSubImage(x, y, width, height, format, img.ptr(), row_length);
+}
+
+bool GLTexture::updateRegion(const cv::Mat& frame, const cv::Rect& roi, GLenum format)
+{
+    checkChannelNum(frame, format);
+
+    if (roi.x < 0 || roi.y < 0 || roi.x + roi.width > frame.cols || roi.y + roi.height > frame.rows)
+    {
+        LOGE("error: roi (%d, %d, %d, %d) is out of frame %d x %d", roi.x, roi.y, roi.width, roi.height, frame.cols, frame.rows);
+        throw std::invalid_argument("error: roi is out of frame");
+        return false;
+    }
+
+    const int row_length = getRowLength(frame);
+    if (row_length < 0)
+        return this->updateRegion(roi.x, roi.y, roi.width, roi.height, frame(roi).clone(), format);
+
+    //source offset by GL_UNPACK_SKIP_PIXELS/SKIP_ROWS, i.e. no ROI header nor copy
+    if (frame.depth() == CV_32F)
+        return this->updateSubImage(roi.x, roi.y, roi.width, roi.height, format, frame.ptr<float>(), row_length, roi.x, roi.y);
+    else
+        return this->updateSubImage(roi.x, roi.y, roi.width, roi.height, format, frame.ptr(), row_length, roi.x, roi.y);
+}
+
+bool GLTexture::updateRegion(const cv::Mat& frame, const std::vector<cv::Rect>& rois, GLenum format)
+{
+    for (const cv::Rect& roi : rois)
+    {
+        bool succ = this->updateRegion(frame, roi, format);
+        if (!succ)
+            return false;
+    }
+
+    return true;
+}
+
+bool GLTexture::updateLevel(int level, const cv::Mat& img, GLenum format)
+{
+    checkChannelNum(img, format);
+
+    if (level < 0 || level >= m_mip_levels)
+    {
+        LOGE("error: invalid mip level %d of %d levels", level, m_mip_levels);
+        throw std::invalid_argument("error: invalid mip level");
+        return false;
+    }
+
+    if (img.cols != this->getLevelWidth(level) || img.rows != this->getLevelHeight(level))
+    {
+        LOGE("error: image %d x %d does not match level %d (%d x %d)", img.cols, img.rows, level, this->getLevelWidth(level), this->getLevelHeight(level));
+        throw std::invalid_argument("error: image does not match level size");
+        return false;
+    }
+
+    const int row_length = getRowLength(img);
+    if (row_length < 0)
+        return this->updateLevel(level, img.clone(), format);
+
+    if (img.depth() == CV_32F)
+        return this->updateSubImage(0, 0, img.cols, img.rows, format, img.ptr<float>(), row_length, 0, 0, level);
+    else
+        return this->updateSubImage(0, 0, img.cols, img.rows, format, img.ptr(), row_length, 0, 0, level);
 }
 
 bool GLTexture::update(const GLTexture& src)
@@ -333,25 +719,11 @@ bool GLTexture::update(const GLTexture& src)
         return false;
     }
 
-    //NOTE(Chen Wei): need further consideration
-
-#if WIN32 || GL_ES_VERSION_3_2
-    glVerify(glCopyImageSubData(src.id(), GL_TEXTURE_2D, 0, 0, 0, 0,
-                                m_tex_id, GL_TEXTURE_2D, 0, 0, 0, 0,
-                                m_width, m_height, 1));
-#else
-    GLFrameBuffer fbo;
-    fbo.init(src);
-    fbo.bind(false, false);
-    glBindTexture(GL_TEXTURE_2D, m_tex_id);
-    glVerify(glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 0, 0, m_width, m_height, 0));
-    fbo.unbind();
-#endif
-
-    return true;
+    //glCopyImageSubData if available, otherwise blit through cached fbos, i.e. no fbo is created per copy
+    return GLContextResources::current().getCopyEngine().copy(src, *this);
 }
 
-bool GLTexture::wrap(GLuint tex_id, int width, int height)
+bool GLTexture::wrap(GLuint tex_id, int width, int height, int level)
 {
     //destroy if necessary
     this->destroy();
@@ -363,7 +735,16 @@ bool GLTexture::wrap(GLuint tex_id, int width, int height)
     m_multi_sample = 1;
     m_target = GL_TEXTURE_2D;
 
+    m_internal_format = 0; //unknown
+    m_explicit_format = false;
+    m_mip_levels = 1;
+    m_mipmaps_dirty = false;
+
+    m_bgr_storage = false;
+    m_vertical_flipped = false;
+
     m_own_texture = false;
+    m_wrapped_level = level;
 
     return true;
 }
@@ -375,16 +756,31 @@ GLTexture::~GLTexture()
 
 void GLTexture::destroy()
 {
-    if (m_own_texture && m_tex_id != 0)
+    if (m_tex_id != 0)
     {
-        glDeleteTextures(1, &m_tex_id);
+        //a wrapped texture is only released, its owner deletes it
+        if (m_own_texture)
+            glDeleteTextures(1, &m_tex_id);
+
         m_tex_id = 0;
+        m_own_texture = true;
+        m_wrapped_level = 0;
 
         m_width = 0;
         m_height = 0;
 
         m_multi_sample = 1;
         m_target = GL_TEXTURE_2D;
+
+        m_internal_format = 0;
+        m_explicit_format = false;
+        m_mip_levels = 1;
+        m_mipmaps_dirty = false;
+
+        m_bgr_storage = false;
+        m_vertical_flipped = false;
+
+        m_staging_pbo.reset();
     }
 }
 
@@ -395,14 +791,35 @@ GLTexture::GLTexture(GLTexture&& rhs) noexcept
     m_height = rhs.m_height;
     m_multi_sample = rhs.m_multi_sample;
     m_target = rhs.m_target;
+    m_internal_format = rhs.m_internal_format;
+    m_explicit_format = rhs.m_explicit_format;
+    m_mip_levels = rhs.m_mip_levels;
+    m_requested_mip_levels = rhs.m_requested_mip_levels;
+    m_mipmap_filter = rhs.m_mipmap_filter;
+    m_mipmaps_dirty = rhs.m_mipmaps_dirty;
+    m_bgr_storage = rhs.m_bgr_storage;
+    m_flip_policy = rhs.m_flip_policy;
+    m_vertical_flipped = rhs.m_vertical_flipped;
+    m_staging_pbo = std::move(rhs.m_staging_pbo);
     m_own_texture = rhs.m_own_texture;
+    m_wrapped_level = rhs.m_wrapped_level;
 
     rhs.m_tex_id = 0;
     rhs.m_width = 0;
     rhs.m_height = 0;
     rhs.m_multi_sample = 1;
     rhs.m_target = GL_TEXTURE_2D;
+    rhs.m_internal_format = 0;
+    rhs.m_explicit_format = false;
+    rhs.m_mip_levels = 1;
+    rhs.m_requested_mip_levels = 1;
+    rhs.m_mipmap_filter = MipmapFilter::HARDWARE;
+    rhs.m_mipmaps_dirty = false;
+    rhs.m_bgr_storage = false;
+    rhs.m_flip_policy = FlipPolicy::FLIP_PIXELS;
+    rhs.m_vertical_flipped = false;
     rhs.m_own_texture = true;
+    rhs.m_wrapped_level = 0;
 }
 
 GLTexture& GLTexture::operator = (GLTexture&& rhs) noexcept
@@ -416,14 +833,35 @@ GLTexture& GLTexture::operator = (GLTexture&& rhs) noexcept
         m_height = rhs.m_height;
         m_multi_sample = rhs.m_multi_sample;
         m_target = rhs.m_target;
+        m_internal_format = rhs.m_internal_format;
+        m_explicit_format = rhs.m_explicit_format;
+        m_mip_levels = rhs.m_mip_levels;
+        m_requested_mip_levels = rhs.m_requested_mip_levels;
+        m_mipmap_filter = rhs.m_mipmap_filter;
+        m_mipmaps_dirty = rhs.m_mipmaps_dirty;
+        m_bgr_storage = rhs.m_bgr_storage;
+        m_flip_policy = rhs.m_flip_policy;
+        m_vertical_flipped = rhs.m_vertical_flipped;
+        m_staging_pbo = std::move(rhs.m_staging_pbo);
         m_own_texture = rhs.m_own_texture;
+        m_wrapped_level = rhs.m_wrapped_level;
 
         rhs.m_tex_id = 0;
         rhs.m_width = 0;
         rhs.m_height = 0;
         rhs.m_multi_sample = 1;
         rhs.m_target = GL_TEXTURE_2D;
+        rhs.m_internal_format = 0;
+        rhs.m_explicit_format = false;
+        rhs.m_mip_levels = 1;
+        rhs.m_requested_mip_levels = 1;
+        rhs.m_mipmap_filter = MipmapFilter::HARDWARE;
+        rhs.m_mipmaps_dirty = false;
+        rhs.m_bgr_storage = false;
+        rhs.m_flip_policy = FlipPolicy::FLIP_PIXELS;
+        rhs.m_vertical_flipped = false;
         rhs.m_own_texture = true;
+        rhs.m_wrapped_level = 0;
     }
     return *this;
 }
@@ -476,7 +914,7 @@ int GLTexture::getWidth() const
     glGetIntegerv(binding_target, &pre_bind_tex_id);
     glBindTexture(m_target, m_tex_id);
     int width = 0;
-    glGetTexLevelParameteriv(m_target, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(m_target, m_wrapped_level, GL_TEXTURE_WIDTH, &width);
     glBindTexture(m_target, pre_bind_tex_id);
     assert(width == m_width);
 #endif
@@ -492,7 +930,7 @@ int GLTexture::getHeight() const
     glGetIntegerv(binding_target, &pre_bind_tex_id);
     glBindTexture(m_target, m_tex_id);
     int height = 0;
-    glGetTexLevelParameteriv(m_target, 0, GL_TEXTURE_HEIGHT, &height);
+    glGetTexLevelParameteriv(m_target, m_wrapped_level, GL_TEXTURE_HEIGHT, &height);
     glBindTexture(m_target, pre_bind_tex_id);
     assert(height == m_height);
 #endif
@@ -505,6 +943,125 @@ unsigned int GLTexture::getMultiSample() const
     return m_multi_sample;
 }
 
+GLint GLTexture::getInternalFormat() const
+{
+    return m_internal_format;
+}
+
+int GLTexture::getMipLevels() const
+{
+    return m_mip_levels;
+}
+
+void GLTexture::setMipLevels(int mip_levels)
+{
+    m_requested_mip_levels = mip_levels;
+}
+
+void GLTexture::setMipmapFilter(MipmapFilter mipmap_filter)
+{
+    m_mipmap_filter = mipmap_filter;
+}
+
+MipmapFilter GLTexture::getMipmapFilter() const
+{
+    return m_mipmap_filter;
+}
+
+int GLTexture::getLevelWidth(int level) const
+{
+    return std::max(m_width >> level, 1);
+}
+
+int GLTexture::getLevelHeight(int level) const
+{
+    return std::max(m_height >> level, 1);
+}
+
+void GLTexture::setLevelRange(int base_level, int max_level) const
+{
+    if (base_level < 0 || base_level > max_level || max_level >= m_mip_levels)
+    {
+        LOGE("error: invalid level range [%d, %d] of %d levels", base_level, max_level, m_mip_levels);
+        throw std::invalid_argument("error: invalid level range");
+    }
+
+    glBindTexture(GL_TEXTURE_2D, m_tex_id);
+    glVerify(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, base_level));
+    glVerify(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, max_level));
+}
+
+bool GLTexture::generateMipmaps() const
+{
+    if (m_tex_id == 0 || m_multi_sample > 1)
+    {
+        LOGE("error: mip levels of invalid or multi-sample texture can not be generated");
+        throw std::invalid_argument("error: mip levels of invalid or multi-sample texture can not be generated");
+        return false;
+    }
+
+    //cleared first, the downsample pass samples this texture as well
+    m_mipmaps_dirty = false;
+
+    if (m_mip_levels <= 1)
+        return true;
+
+    const MipmapFilter filter = (m_mipmap_filter == MipmapFilter::NONE) ? MipmapFilter::HARDWARE : m_mipmap_filter;
+
+    return GLContextResources::current().getMipGenerator().generate(*this, filter);
+}
+
+bool GLTexture::updateMipmaps() const
+{
+    if (!m_mipmaps_dirty || m_mip_levels <= 1 || m_mipmap_filter == MipmapFilter::NONE)
+        return true;
+
+    return this->generateMipmaps();
+}
+
+void GLTexture::markContentsChanged() const
+{
+    m_mipmaps_dirty = true;
+}
+
+bool GLTexture::isBGRStorage() const
+{
+    return m_bgr_storage;
+}
+
+void GLTexture::setFlipPolicy(FlipPolicy flip_policy)
+{
+    m_flip_policy = flip_policy;
+}
+
+FlipPolicy GLTexture::getFlipPolicy() const
+{
+    return m_flip_policy;
+}
+
+bool GLTexture::isVerticalFlipped() const
+{
+    return m_vertical_flipped;
+}
+
+void GLTexture::setVerticalFlipped(bool vertical_flipped)
+{
+    m_vertical_flipped = vertical_flipped;
+}
+
+void GLTexture::setBGRStorage(bool bgr_storage)
+{
+    m_bgr_storage = bgr_storage;
+
+    //swizzle is not available for multi-sample texture on OpenGLES 3.0
+    if (m_multi_sample > 1)
+        return;
+
+    glBindTexture(m_target, m_tex_id);
+    glVerify(glTexParameteri(m_target, GL_TEXTURE_SWIZZLE_R, bgr_storage ? GL_BLUE : GL_RED));
+    glVerify(glTexParameteri(m_target, GL_TEXTURE_SWIZZLE_B, bgr_storage ? GL_RED : GL_BLUE));
+}
+
 template <typename Scale>
 bool GLTexture::readTextureData(Scale* data, GLenum format, int data_size_in_byte) const
 {
@@ -522,6 +1079,10 @@ bool GLTexture::readTextureData(Scale* data, GLenum format, int data_size_in_byt
         return false;
     }
 
+    //multi-sample texture can not be read directly, read a resolved copy
+    if (m_multi_sample > 1)
+        return this->resolveMultiSample().readTextureData(data, format, data_size_in_byte);
+
     if (m_target != GL_TEXTURE_2D)
     {
         LOGE("error: invalid texture target, current only support GL_TEXTURE_2D");
@@ -563,7 +1124,6 @@ bool GLTexture::readTextureData(Scale* data, GLenum format, int data_size_in_byt
         throw std::invalid_argument("error: unsupported data type");
         return false;
     }
-    glVerify(glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, data));
     this->unbind();
 #else
     //NOTE(Chen Wei): OpenGLES has no glGetTexImage
@@ -587,12 +1147,76 @@ bool GLTexture::read(float* data, GLenum format, int data_size_in_byte) const
     return this->readTextureData(data, format, data_size_in_byte);
 }
 
+bool GLTexture::readLevel(int level, cv::Mat& img, GLenum format) const
+{
+    if (m_tex_id == 0 || m_multi_sample > 1)
+    {
+        LOGE("error: levels of invalid or multi-sample texture can not be read");
+        throw std::invalid_argument("error: levels of invalid or multi-sample texture can not be read");
+        return false;
+    }
+
+    if (level < 0 || level >= m_mip_levels)
+    {
+        LOGE("error: invalid mip level %d of %d levels", level, m_mip_levels);
+        throw std::invalid_argument("error: invalid mip level");
+        return false;
+    }
+
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    //levels are read as they are, i.e. pending generation is done first
+    if (level > 0)
+        this->updateMipmaps();
+
+    GLenum storage_format = GL_RGBA;
+    GLenum storage_type = GL_UNSIGNED_BYTE;
+    const bool use_float = queryFormatAndType(m_internal_format, storage_format, storage_type) &&
+                           (storage_type == GL_FLOAT || storage_type == GL_HALF_FLOAT);
+
+    const int level_width = this->getLevelWidth(level);
+    const int level_height = this->getLevelHeight(level);
+
+    img.create(level_height, level_width, use_float ? CV_32FC(getChannelNum(format)) : CV_8UC(getChannelNum(format)));
+
+#if WIN32 || __MACOS__
+    this->bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glVerify(glGetTexImage(GL_TEXTURE_2D, level, format, use_float ? GL_FLOAT : GL_UNSIGNED_BYTE, img.data));
+    this->unbind();
+#else
+    //NOTE: OpenGLES has no glGetTexImage, read through a fbo attached to the level
+    GLFrameBuffer fbo;
+    fbo.init(m_tex_id, level_width, level_height, level);
+
+    if (use_float)
+        fbo.read(img.ptr<float>(), format);
+    else
+        fbo.read(img.ptr(), format);
+#endif
+
+    return true;
+}
+
 bool GLTexture::read(cv::Mat& img, GLenum format, bool convert_to_bgr, bool vertical_flip) const
 {
+    //swizzle pass can not sample multi-sample texture either
+    if (m_multi_sample > 1)
+        return this->resolveMultiSample().read(img, format, convert_to_bgr, vertical_flip);
+
     //for compatibility
     if (format == GL_LUMINANCE)
         format = GL_RED;
 
+    if (convert_to_bgr && format != GL_RGB && format != GL_RGBA)
+    {
+        LOGE("error: unsupported format to convert_to_bgr");
+        throw std::invalid_argument("error: unsupported format to convert_to_bgr");
+        return false;
+    }
+
     int type = CV_8UC3;
     if (format == GL_RED)
         type = CV_8UC1;
@@ -606,19 +1230,66 @@ bool GLTexture::read(cv::Mat& img, GLenum format, bool convert_to_bgr, bool vert
     //NOTE(Chen Wei): warning: GL_RGB may not support by ios (gles 3.0), so we change to read RGBA
     //                opengl es may only support GL_RGBA, compatibility need further consideration
 #if __IOS__
-    bool need_convert_back = false;
-    if (format == GL_RGB)
-    {
+    const bool drop_alpha = (format == GL_RGB);
+    if (drop_alpha)
         format = GL_RGBA;
-        type = CV_8UC4;
+#else
+    const bool drop_alpha = false;
+#endif
 
-        need_convert_back = true;
-    }
+    //alpha is dropped in the same pass as flip
+    const PixelConversion conversion = drop_alpha ? PixelConversion::RGBA_TO_RGB : PixelConversion::COPY;
+
+    const bool is_color = (format == GL_RGB || format == GL_RGBA);
+
+    //rows of FLIP_TEXCOORD texture are already upside down
+    const bool need_flip = (vertical_flip != m_vertical_flipped);
+
+    bool succ = false;
+
+    GLenum read_format = format;
+
+#if WIN32 || __MACOS__
+    //glGetTexImage ignores texture swizzle, i.e. returns storage order, the driver swaps channels during transfer
+    if (is_color && convert_to_bgr != m_bgr_storage)
+        read_format = (format == GL_RGB) ? GL_BGR : GL_BGRA;
+
+    const bool use_swizzle_pass = false;
+#else
+    //sampling honors texture swizzle, i.e. the swizzle pass always sees RGB order
+    const bool use_swizzle_pass = is_color && (convert_to_bgr || m_bgr_storage);
 #endif
 
-    img.create(m_height, m_width, type);
+    if (use_swizzle_pass)
+    {
+        GLSwizzlePass& swizzle_pass = GLContextResources::current().getSwizzlePass();
+
+        //flip is done by the pass as well, the pass honors m_vertical_flipped itself
+        if (drop_alpha)
+        {
+            cv::Mat rgba(m_height, m_width, CV_8UC4);
+            succ = swizzle_pass.read(*this, rgba.data, GL_RGBA, convert_to_bgr, vertical_flip);
+
+            img.create(m_height, m_width, type);
+            convertImage(rgba.data, rgba.step[0], img.data, img.step[0], m_width, m_height, 4, conversion);
+        }
+        else
+        {
+            img.create(m_height, m_width, type);
+            succ = swizzle_pass.read(*this, img.data, format, convert_to_bgr, vertical_flip);
+        }
+    }
+    else if (need_flip || drop_alpha)
+    {
+        //rows are reversed (and alpha dropped) while copying out of the pack-PBO, i.e. no extra cv::flip/cvtColor pass
+        succ = this->readAsync(read_format, GL_UNSIGNED_BYTE).copyTo(img, conversion, need_flip);
+    }
+    else
+    {
+        img.create(m_height, m_width, type);
+        succ = this->read(img.data, read_format, img.total() * img.elemSize());
+    }
 
-    bool succ = this->read(img.data, format, img.total() * img.elemSize());
     if (!succ)
     {
         LOGE("error: can not read texture");
@@ -626,42 +1297,80 @@ bool GLTexture::read(cv::Mat& img, GLenum format, bool convert_to_bgr, bool vert
         return false;
     }
 
-#if __IOS__
-    if (need_convert_back)
+    return true;
+}
+
+GLAsyncReadback GLTexture::readAsync(GLenum format, GLenum type) const
+{
+    if (m_tex_id == 0)
     {
-        cv::cvtColor(img, img, CV_RGBA2RGB);
+        LOGE("error: invalid texture id: %d", m_tex_id);
+        throw std::invalid_argument("error: invalid texture id");
     }
-#endif
 
-    if (convert_to_bgr)
+    if (m_multi_sample > 1)
+        return this->resolveMultiSample().readAsync(format, type);
+
+    if (m_target != GL_TEXTURE_2D)
     {
-        if (format == GL_RGB)
-        {
-            cv::cvtColor(img, img, CV_RGB2BGR);
-        }
-        else if (format == GL_RGBA)
-        {
-            cv::cvtColor(img, img, CV_RGBA2BGRA);
-        }
-        else
-        {
-            LOGE("error: unsupported format to convert_to_bgr");
-            throw std::invalid_argument("error: unsupported format to convert_to_bgr");
-            return false;
-        }
+        LOGE("error: invalid texture target, current only support GL_TEXTURE_2D");
+        throw std::invalid_argument("error: invalid texture target, current only support GL_TEXTURE_2D");
     }
 
-    if (vertical_flip)
-        cv::flip(img, img, 0);
+#if WIN32 || __MACOS__
+    GLAsyncReadback readback(m_width, m_height, format, type);
 
-    return true;
+    this->bind();
+    readback.getPixelBuffer().bind();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, GLAsyncReadback::PACK_ALIGNMENT);
+
+    //data pointer is an offset into the bound GL_PIXEL_PACK_BUFFER, i.e. returns without waiting for GPU
+    glVerify(glGetTexImage(GL_TEXTURE_2D, 0, readback.getFormat(), type, nullptr));
+
+    readback.getPixelBuffer().unbind();
+    this->unbind();
+
+    readback.getFence().insert();
+    glFlush();
+
+    return readback;
+#else
+    //NOTE(Chen Wei): OpenGLES has no glGetTexImage
+    GLFrameBuffer fbo;
+    fbo.init(*this);
+    return fbo.readAsync(format, type);
+#endif
+}
+
+GLTexture GLTexture::resolveMultiSample() const
+{
+    //NOTE: prefer GLFrameBuffer with multi_sample > 1, it keeps a resolved companion and resolves only if changed,
+    //      a standalone multi-sample texture is resolved into a temporary texture on every read
+    GLTexture resolved;
+    resolved.allocate(m_width, m_height, m_internal_format != 0 ? m_internal_format : GL_RGBA8);
+    resolved.m_bgr_storage = m_bgr_storage;
+    resolved.m_vertical_flipped = m_vertical_flipped;
+
+    GLContextResources::current().getCopyEngine().resolve(*this, resolved);
+
+    return resolved;
+}
+
+GLMappedImage GLTexture::readMapped(GLenum format, GLenum type) const
+{
+    //FLIP_TEXCOORD storage is already top-down
+    return GLMappedImage(this->readAsync(format, type), !m_vertical_flipped);
 }
 
 bool GLTexture::save(const std::string& image_file, bool vertical_flip) const
 {
-    std::vector<unsigned char> data(3 * m_height * m_width);
+    //GL_RGBA is the readback format guaranteed by opengl es, alpha is dropped while flipping,
+    //readback ignores texture swizzle, i.e. red and blue of BGR storage are swapped back in the same copy
+    const PixelConversion conversion = m_bgr_storage ? PixelConversion::RGBA_TO_BGR : PixelConversion::RGBA_TO_RGB;
 
-    bool succ = this->read(data.data(), GL_RGBA);
+    cv::Mat rgb;
+    bool succ = this->readAsync(GL_RGBA, GL_UNSIGNED_BYTE).copyTo(rgb, conversion, vertical_flip != m_vertical_flipped);
     if (!succ)
     {
         LOGE("error: can not read texture");
@@ -669,9 +1378,7 @@ bool GLTexture::save(const std::string& image_file, bool vertical_flip) const
         return false;
     }
 
-    stbi_flip_vertically_on_write(vertical_flip);
-    stbi_write_png(image_file.c_str(), m_width, m_height, 3, data.data(), 3 * m_width);
-    stbi_flip_vertically_on_write(false);
+    stbi_write_png(image_file.c_str(), m_width, m_height, 3, rgb.data, static_cast<int>(rgb.step[0]));
 
     return true;
 }
@@ -680,14 +1387,11 @@ GLint GLTexture::getInternalFormat(GLenum format, bool use_float)
 {
     //NOTE(Chen Wei): opengl internal format can not be GL_BGR/GL_BGRA
 
-#if WIN32 || __MACOS__
-    //NOTE(Chen Wei): OpenGLES has no GL_BGR or GL_BGRA
     if (format == GL_BGR)
-        return GL_RGB;
+        format = GL_RGB;
 
     if (format == GL_BGRA)
-        return GL_RGBA;
-#endif
+        format = GL_RGBA;
 
     //NOTE(Chen Wei): need further considerations
 
@@ -723,6 +1427,119 @@ GLint GLTexture::getInternalFormat(GLenum format, bool use_float)
     }
 }
 
+GLint GLTexture::getSizedInternalFormat(GLint internal_format)
+{
+    //NOTE: glTexStorage2D only accepts sized internal format
+    if (internal_format == GL_DEPTH_COMPONENT)
+        return GL_DEPTH_COMPONENT24;
+
+    return internal_format;
+}
+
+void GLTexture::getFormatAndType(GLint internal_format, GLenum& format, GLenum& type)
+{
+    if (!queryFormatAndType(internal_format, format, type))
+        throw std::invalid_argument("error: unsupported internal format");
+}
+
+bool GLTexture::queryFormatAndType(GLint internal_format, GLenum& format, GLenum& type)
+{
+    switch (internal_format)
+    {
+    case GL_R8:                 format = GL_RED;             type = GL_UNSIGNED_BYTE; break;
+    case GL_RG8:                format = GL_RG;              type = GL_UNSIGNED_BYTE; break;
+    case GL_RGB8:               format = GL_RGB;             type = GL_UNSIGNED_BYTE; break;
+    case GL_RGBA8:              format = GL_RGBA;            type = GL_UNSIGNED_BYTE; break;
+    case GL_R16F:               format = GL_RED;             type = GL_HALF_FLOAT;    break;
+    case GL_RG16F:              format = GL_RG;              type = GL_HALF_FLOAT;    break;
+    case GL_RGB16F:             format = GL_RGB;             type = GL_HALF_FLOAT;    break;
+    case GL_RGBA16F:            format = GL_RGBA;            type = GL_HALF_FLOAT;    break;
+    case GL_R11F_G11F_B10F:     format = GL_RGB;             type = GL_HALF_FLOAT;    break;
+    case GL_RGB10_A2:           format = GL_RGBA;            type = GL_UNSIGNED_INT_2_10_10_10_REV; break;
+#if WIN32 || __MACOS__
+    //NOTE: 16-bit normalized formats are not part of OpenGLES core (EXT_texture_norm16)
+    case GL_R16:                format = GL_RED;             type = GL_UNSIGNED_SHORT; break;
+    case GL_RG16:               format = GL_RG;              type = GL_UNSIGNED_SHORT; break;
+    case GL_RGBA16:             format = GL_RGBA;            type = GL_UNSIGNED_SHORT; break;
+#endif
+    case GL_R32F:               format = GL_RED;             type = GL_FLOAT;         break;
+    case GL_RG32F:              format = GL_RG;              type = GL_FLOAT;         break;
+    case GL_RGB32F:             format = GL_RGB;             type = GL_FLOAT;         break;
+    case GL_RGBA32F:            format = GL_RGBA;            type = GL_FLOAT;         break;
+    case GL_DEPTH_COMPONENT:
+    case GL_DEPTH_COMPONENT24:  format = GL_DEPTH_COMPONENT; type = GL_UNSIGNED_INT;  break;
+    case GL_DEPTH_COMPONENT32F: format = GL_DEPTH_COMPONENT; type = GL_FLOAT;         break;
+    case GL_DEPTH_COMPONENT16:  format = GL_DEPTH_COMPONENT; type = GL_UNSIGNED_SHORT; break;
+    case GL_DEPTH24_STENCIL8:   format = GL_DEPTH_STENCIL;   type = GL_UNSIGNED_INT_24_8; break;
+    case GL_DEPTH32F_STENCIL8:  format = GL_DEPTH_STENCIL;   type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+bool GLTexture::isUploadCompatible(GLint internal_format, GLenum format, bool use_float)
+{
+    //packed 16-bit formats take unsigned byte data on every platform
+    if (internal_format == GL_RGB565)
+        return !use_float && getChannelNum(getUploadFormat(format)) == 3;
+
+    if (internal_format == GL_RGB5_A1 || internal_format == GL_RGBA4)
+        return !use_float && getChannelNum(getUploadFormat(format)) == 4;
+
+    GLenum storage_format = GL_RGBA;
+    GLenum storage_type = GL_UNSIGNED_BYTE;
+    if (!queryFormatAndType(internal_format, storage_format, storage_type))
+        return false;
+
+    //depth storage is always derived from data
+    if (storage_format == GL_DEPTH_COMPONENT || storage_format == GL_DEPTH_STENCIL || format == GL_DEPTH_COMPONENT)
+        return false;
+
+    if (getChannelNum(storage_format) != getChannelNum(getUploadFormat(format)))
+        return false;
+
+    const bool float_storage = (storage_type == GL_HALF_FLOAT || storage_type == GL_FLOAT);
+    if (use_float)
+        return float_storage;
+
+#if WIN32 || __MACOS__
+    //desktop opengl converts unsigned byte into any normalized format
+    return !float_storage;
+#else
+    //e.g. GL_RGB10_A2 only takes GL_UNSIGNED_INT_2_10_10_10_REV data on OpenGLES
+    return storage_type == GL_UNSIGNED_BYTE;
+#endif
+}
+
+int GLTexture::getRowLength(const cv::Mat& mat)
+{
+    const size_t pixel_size = mat.elemSize();
+    const size_t step = mat.step[0];
+
+    if (pixel_size == 0 || step % pixel_size != 0)
+        return -1;
+
+    return static_cast<int>(step / pixel_size);
+}
+
+GLenum GLTexture::getUploadFormat(GLenum format)
+{
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        return GL_RED;
+
+    //OpenGLES has no GL_BGR/GL_BGRA, red and blue are swapped by texture swizzle on all platforms
+    if (format == GL_BGR)
+        return GL_RGB;
+
+    if (format == GL_BGRA)
+        return GL_RGBA;
+
+    return format;
+}
+
 void GLTexture::checkChannelNum(const cv::Mat& mat, GLenum format)
 {
     int channel_num = mat.channels();
@@ -748,15 +1565,11 @@ void GLTexture::checkChannelNum(const cv::Mat& mat, GLenum format)
     if (format == GL_RGBA && channel_num != 4)
         throw std::invalid_argument("error: channel num not match");
 
-#if WIN32 || __MACOS__
-
     if (format == GL_BGR && channel_num != 3)
         throw std::invalid_argument("error: channel num not match");
 
     if (format == GL_BGRA && channel_num != 4)
         throw std::invalid_argument("error: channel num not match");
-
-#endif
 }
 
 int GLTexture::getChannelNum(GLenum format)
@@ -776,16 +1589,12 @@ int GLTexture::getChannelNum(GLenum format)
     if (format == GL_RGBA)
         return 4;
 
-#if WIN32 || __MACOS__
-
     if (format == GL_BGR)
         return 3;
 
     if (format == GL_BGRA)
         return 4;
 
-#endif
-
     throw std::invalid_argument("error: unsupported format");
 }
 
@@ -7,18 +7,46 @@
 
 #pragma once
 
+#include <climits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "opencv2/opencv.hpp"
 
 #include "gl_include.h"
 
+#include "gl_pixel_buffer.h"
+#include "gl_async_readback.h"
+#include "gl_mapped_image.h"
+
 namespace luna {
 
+//how a vertical flip requested on upload (update/init with vertical_flip = true) is realized
+enum class FlipPolicy
+{
+    FLIP_PIXELS,    //!< rows are reversed while staging the upload into a PBO, i.e. a single copy
+    FLIP_TEXCOORD,  //!< pixels are uploaded as is and the texture is marked flipped, sampling passes flip texture coordinates
+};
+
+//how levels 1..n-1 are derived from level 0 (see GLTexture::setMipLevels)
+enum class MipmapFilter
+{
+    NONE,       //!< levels are written by the user (updateLevel, rendering into a level), never generated lazily
+    HARDWARE,   //!< glGenerateMipmap, filter is up to the driver (usually 2x2 box)
+    BOX,        //!< 2x2 average in a downsample pass
+    GAUSSIAN,   //!< 4x4 binomial in a downsample pass, less aliasing of thin features, a bit blurrier
+};
+
+//NOTE: copy, multi-sample resolve, mip generation and BGR readback (OpenGLES) use the helper passes of
+//      GLContextResources::current(), see there for their lifetime.
+
 class GLTexture
 {
 public:
 
+    static constexpr int KEEP_MIP_LEVELS = INT_MIN; //see allocate()
+
     GLTexture() = default;
 
     GLTexture(int width, int height, GLenum format = GL_RGB, const unsigned char* data = nullptr, unsigned int multi_sample = 1);
@@ -37,6 +65,17 @@ public:
 
     bool init(const cv::Mat& img, GLenum format = GL_RGB, bool vertical_flip = false, unsigned int multi_sample = 1);
 
+    //allocate immutable storage (glTexStorage2D) without data, mip_levels <= 0 means full mip chain,
+    //KEEP_MIP_LEVELS keeps the count set by setMipLevels (1 unless set), an explicit count replaces it
+    //NOTE: explicit internal format is kept by later update() as long as data can be converted into it,
+    //      e.g. GL_RGBA16F/GL_R11F_G11F_B10F for HDR intermediates (float data is converted to half on CPU),
+    //      GL_RGB565/GL_RGB5_A1/GL_RGBA4, GL_RGB10_A2 & GL_R16/GL_RG16/GL_RGBA16 (unsigned byte data on desktop only),
+    //      update() throws for data that can not be converted, i.e. the storage format is never changed silently
+    bool allocate(int width, int height, GLint internal_format, unsigned int multi_sample = 1, int mip_levels = KEEP_MIP_LEVELS);
+
+    //NOTE: storage is only reallocated when width/height/format changes, otherwise glTexSubImage2D is used,
+    //      reallocation creates a new texture object (immutable storage), i.e. id() changes and fbos
+    //      initialized from this texture must be initialized again, wrapped textures throw instead
     bool update(int width, int height, GLenum format, const unsigned char* data);
 
     bool update(int width, int height, GLenum format, const float* data);  //not clamped to [0, 1]
@@ -45,7 +84,19 @@ public:
 
     bool update(const GLTexture& src);
 
-    bool wrap(GLuint tex_id, int width, int height);
+    //upload top-left width x height of img into sub-rectangle (x, y, width, height) of allocated storage,
+    //img.step is honored by GL_UNPACK_ROW_LENGTH, i.e. a ROI of a larger frame is uploaded without clone
+    //NOTE: (x, y) is in storage coordinates, rows are uploaded as is (no vertical flip)
+    bool updateRegion(int x, int y, int width, int height, const cv::Mat& img, GLenum format = GL_RGB);
+
+    //upload roi of frame into the same rectangle of texture, e.g. stream only the changed tiles of a frame
+    bool updateRegion(const cv::Mat& frame, const cv::Rect& roi, GLenum format = GL_RGB);
+
+    bool updateRegion(const cv::Mat& frame, const std::vector<cv::Rect>& rois, GLenum format = GL_RGB);
+
+    //level: the wrapped texture is a view of this level, width/height are its size (see GLFrameBuffer::init)
+    //storage of the wrapped texture is never (re)allocated, destroy() releases it without deleting
+    bool wrap(GLuint tex_id, int width, int height, int level = 0);
 
     ~GLTexture();
 
@@ -81,29 +132,126 @@ public:
 
     unsigned int getMultiSample() const;
 
+    GLint getInternalFormat() const; //sized internal format of allocated storage, 0 if unknown
+
+    int getMipLevels() const;
+
+    //mip levels allocated by later init/update, kept across re-initialization, <= 0 means full mip chain,
+    //min filter GL_LINEAR becomes GL_LINEAR_MIPMAP_LINEAR once more than one level is allocated
+    //NOTE: levels are generated lazily, i.e. only when the texture is sampled (GLShader::setTexture)
+    //      after level 0 was written, a single pass writing level 0 of a frame costs a single generation
+    void setMipLevels(int mip_levels);
+
+    void setMipmapFilter(MipmapFilter mipmap_filter);
+
+    MipmapFilter getMipmapFilter() const;
+
+    int getLevelWidth(int level) const;
+
+    int getLevelHeight(int level) const;
+
+    //upload img (of level size) into level, rows are uploaded as is, writing level 0 invalidates the other levels
+    bool updateLevel(int level, const cv::Mat& img, GLenum format = GL_RGB);
+
+    //read level in storage order (no flip, no red/blue swap), rows are bottom-up,
+    //CV_32F for float & half-float storage, CV_8U otherwise
+    bool readLevel(int level, cv::Mat& img, GLenum format = GL_RGBA) const;
+
+    //restrict sampled levels (GL_TEXTURE_BASE_LEVEL/MAX_LEVEL), e.g. sample a single level with texture()
+    void setLevelRange(int base_level, int max_level) const;
+
+    //regenerate levels 1..n-1 from level 0 right now, NONE falls back to HARDWARE
+    bool generateMipmaps() const;
+
+    //regenerate only if level 0 changed since the last generation, no-op for MipmapFilter::NONE
+    bool updateMipmaps() const;
+
+    //level 0 was written behind the back of GLTexture, e.g. rendered through a fbo wrapping it or by a compute shader
+    void markContentsChanged() const;
+
+    //true if storage holds BGR(A) uploaded as is, red and blue are swapped back by texture swizzle on sampling
+    bool isBGRStorage() const;
+
+    //set texture swizzle for BGR(A) storage, called by update() automatically
+    void setBGRStorage(bool bgr_storage);
+
+    //set before init/update, kept across re-initialization
+    void setFlipPolicy(FlipPolicy flip_policy);
+
+    FlipPolicy getFlipPolicy() const;
+
+    //true if storage rows are upside down w.r.t. opengl convention (FLIP_TEXCOORD),
+    //i.e. passes sampling this texture should use (u, 1 - v), read/save account for it automatically
+    bool isVerticalFlipped() const;
+
+    void setVerticalFlipped(bool vertical_flipped);
+
     bool read(unsigned char* data, GLenum format = GL_RGB, int data_size_in_byte = -1) const; //-1 means do not check
 
     bool read(float* data, GLenum format = GL_RGB, int data_size_in_byte = -1) const;  //-1 means do not check
 
+    //NOTE: red/blue swap for convert_to_bgr (or BGR storage) is done on GPU, i.e. no cv::cvtColor
     bool read(cv::Mat& img, GLenum format = GL_RGB, bool convert_to_bgr = true, bool vertical_flip = false) const;
 
     bool save(const std::string& image_file, bool vertical_flip = false) const;
 
+    //start readback into a pooled pack-PBO and return immediately, result is available a few frames later
+    //NOTE: pixels are in storage order, i.e. texture swizzle is not applied (red and blue are swapped
+    //      for BGR storage, see isBGRStorage(), e.g. copyTo with SWAP_RED_BLUE/RGBA_TO_BGR), rows as stored
+    GLAsyncReadback readAsync(GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE) const;
+
+    //read into a pack-PBO and map it, zero-copy alternative of read(cv::Mat&), storage order as readAsync(),
+    //i.e. rows are bottom-up unless isVerticalFlipped() (see GLMappedImage::isBottomUp)
+    GLMappedImage readMapped(GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE) const;
+
 private:
 
     void setupTexture(unsigned int multi_sample);
 
+    void allocateStorage(int width, int height, GLint internal_format);
+
     template <typename Scale>
     bool updateTextureData(int width, int height, GLenum format, const Scale* data);
 
+    //(re)allocate storage & setup swizzle for img if necessary, no upload
+    void updateStorage(const cv::Mat& img, GLenum format);
+
+    //upload through a staging PBO, rows are reversed if vertical_flip and float is converted to half for half-float storage,
+    //i.e. a single copy with no intermediate image in client memory
+    bool updateStaged(const cv::Mat& img, GLenum format, bool vertical_flip);
+
+    //glTexSubImage2D with GL_UNPACK_ROW_LENGTH/SKIP_PIXELS/SKIP_ROWS, pixel store state is restored afterwards
+    template <typename Scale>
+    bool updateSubImage(int x, int y, int width, int height, GLenum format, const Scale* data,
+                        int row_length = 0, int skip_pixels = 0, int skip_rows = 0, int level = 0);
+
     template <typename Scale>
     bool readTextureData(Scale * data, GLenum format = GL_RGB, int data_size_in_byte = -1) const;
 
+    //single-sample copy of multi-sample texture for readback
+    GLTexture resolveMultiSample() const;
+
 public:
     static GLint getInternalFormat(GLenum format, bool use_float);
 
+    static GLint getSizedInternalFormat(GLint internal_format);
+
+    static void getFormatAndType(GLint internal_format, GLenum& format, GLenum& type);
+
+    //same as getFormatAndType, but returns false for unknown internal format instead of throwing
+    static bool queryFormatAndType(GLint internal_format, GLenum& format, GLenum& type);
+
+    //true if data of format (float or unsigned byte) can be uploaded into storage of internal_format
+    static bool isUploadCompatible(GLint internal_format, GLenum format, bool use_float);
+
+    //client format accepted by glTexSubImage2D, i.e. GL_LUMINANCE -> GL_RED, GL_BGR(A) -> GL_RGB(A) (see setBGRStorage)
+    static GLenum getUploadFormat(GLenum format);
+
     static void checkChannelNum(const cv::Mat & mat, GLenum format);
 
+    //pixels per row of mat for GL_UNPACK_ROW_LENGTH, -1 if step is not a multiple of pixel size
+    static int getRowLength(const cv::Mat& mat);
+
     static int getChannelNum(GLenum format);
 
 private:
@@ -116,7 +264,24 @@ private:
 
     GLenum m_target = GL_TEXTURE_2D;
 
+    GLint m_internal_format = 0; //0 means storage not allocated
+    bool m_explicit_format = false; //internal format chosen by allocate(), never replaced by update()
+
+    int m_mip_levels = 1;
+
+    int m_requested_mip_levels = 1; //kept across re-initialization
+    MipmapFilter m_mipmap_filter = MipmapFilter::HARDWARE;
+    mutable bool m_mipmaps_dirty = false; //level 0 written since the last generation
+
+    bool m_bgr_storage = false;
+
+    FlipPolicy m_flip_policy = FlipPolicy::FLIP_PIXELS;
+    bool m_vertical_flipped = false;
+
+    std::unique_ptr<GLPixelBuffer> m_staging_pbo; //created on first flipped upload
+
     bool m_own_texture = true;
+    int m_wrapped_level = 0; //level of a wrapped texture that width/height refer to
 };
 
 }//end of namespace luna
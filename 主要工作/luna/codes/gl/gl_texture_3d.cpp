@@ -0,0 +1,251 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl 3d texture, e.g. 3d color lookup table
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+
+#include "gl_texture_3d.h"
+
+namespace luna {
+
+GLTexture3D::GLTexture3D(int width, int height, int depth, GLint internal_format)
+{
+    bool succ = this->init(width, height, depth, internal_format);
+    if (!succ)
+    {
+        LOGE("error: can not init GLTexture3D");
+        throw std::invalid_argument("error: can not init GLTexture3D");
+    }
+}
+
+bool GLTexture3D::init(int width, int height, int depth, GLint internal_format)
+{
+    if (width <= 0 || height <= 0 || depth <= 0)
+    {
+        LOGE("error: invalid 3d texture size: %d x %d x %d", width, height, depth);
+        throw std::invalid_argument("error: invalid 3d texture size");
+        return false;
+    }
+
+    GLint MAX_3D_TEXTURE_SIZE = 0;
+    glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &MAX_3D_TEXTURE_SIZE);
+
+    if (width > MAX_3D_TEXTURE_SIZE || height > MAX_3D_TEXTURE_SIZE || depth > MAX_3D_TEXTURE_SIZE)
+    {
+        LOGE("error: 3d texture size %d x %d x %d exceeds GL_MAX_3D_TEXTURE_SIZE(%d)", width, height, depth, MAX_3D_TEXTURE_SIZE);
+        throw std::invalid_argument("error: 3d texture size exceeds GL_MAX_3D_TEXTURE_SIZE");
+        return false;
+    }
+
+    //destroy if necessary
+    this->destroy();
+
+    m_width = width;
+    m_height = height;
+    m_depth = depth;
+    m_internal_format = GLTexture::getSizedInternalFormat(internal_format);
+
+    glVerify(glGenTextures(1, &m_tex_id));
+    glVerify(glBindTexture(GL_TEXTURE_3D, m_tex_id));
+
+#if __MACOS__
+    //NOTE: macOS only supports OpenGL 4.1, glTexStorage3D (4.2) is not available
+    GLenum format = GL_RGBA;
+    GLenum type = GL_UNSIGNED_BYTE;
+    GLTexture::getFormatAndType(m_internal_format, format, type);
+
+    glVerify(glTexImage3D(GL_TEXTURE_3D, 0, m_internal_format, m_width, m_height, m_depth, 0, format, type, nullptr));
+#else
+    glVerify(glTexStorage3D(GL_TEXTURE_3D, 1, m_internal_format, m_width, m_height, m_depth));
+#endif
+
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    //trilinear, i.e. a lookup between lattice points interpolates the 8 neighbours
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    glVerify(glBindTexture(GL_TEXTURE_3D, 0));
+
+    return true;
+}
+
+GLTexture3D::~GLTexture3D()
+{
+    this->destroy();
+}
+
+void GLTexture3D::destroy()
+{
+    if (m_tex_id != 0)
+    {
+        glDeleteTextures(1, &m_tex_id);
+        m_tex_id = 0;
+
+        m_width = 0;
+        m_height = 0;
+        m_depth = 0;
+        m_internal_format = 0;
+    }
+}
+
+GLTexture3D::GLTexture3D(GLTexture3D&& rhs) noexcept
+{
+    m_tex_id = rhs.m_tex_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_depth = rhs.m_depth;
+    m_internal_format = rhs.m_internal_format;
+
+    rhs.m_tex_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_depth = 0;
+    rhs.m_internal_format = 0;
+}
+
+GLTexture3D& GLTexture3D::operator = (GLTexture3D&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_tex_id = rhs.m_tex_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_depth = rhs.m_depth;
+    m_internal_format = rhs.m_internal_format;
+
+    rhs.m_tex_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_depth = 0;
+    rhs.m_internal_format = 0;
+
+    return *this;
+}
+
+bool GLTexture3D::update(const float* data, GLenum format)
+{
+    return this->updateTextureData(data, format, GL_FLOAT);
+}
+
+bool GLTexture3D::update(const unsigned char* data, GLenum format)
+{
+    return this->updateTextureData(data, format, GL_UNSIGNED_BYTE);
+}
+
+bool GLTexture3D::updateTextureData(const void* data, GLenum format, GLenum type)
+{
+    if (m_tex_id == 0)
+    {
+        LOGE("error: invalid texture id: %d", m_tex_id);
+        throw std::invalid_argument("error: invalid texture id");
+        return false;
+    }
+
+    if (data == nullptr)
+    {
+        LOGE("error: data is nullptr");
+        throw std::invalid_argument("error: data is nullptr");
+        return false;
+    }
+
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    if (!GLTexture::isUploadCompatible(m_internal_format, format, type == GL_FLOAT))
+    {
+        LOGE("error: data format is not compatible with storage of 3d texture");
+        throw std::invalid_argument("error: data format is not compatible with storage of 3d texture");
+        return false;
+    }
+
+    this->bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    glVerify(glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, m_width, m_height, m_depth, format, type, data));
+
+    this->unbind();
+
+    return true;
+}
+
+void GLTexture3D::setFilter(GLenum min_filter, GLenum mag_filter)
+{
+    this->bind();
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, min_filter);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, mag_filter);
+    this->unbind();
+}
+
+void GLTexture3D::setWrapMode(GLenum wrap_s, GLenum wrap_t, GLenum wrap_r)
+{
+    this->bind();
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, wrap_s);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, wrap_t);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, wrap_r);
+    this->unbind();
+}
+
+void GLTexture3D::bind() const
+{
+    glBindTexture(GL_TEXTURE_3D, m_tex_id);
+}
+
+void GLTexture3D::bind(GLuint tex_unit) const
+{
+    glActiveTexture(tex_unit);
+    glBindTexture(GL_TEXTURE_3D, m_tex_id);
+}
+
+void GLTexture3D::unbind() const
+{
+    glBindTexture(GL_TEXTURE_3D, 0);
+}
+
+GLuint GLTexture3D::id() const
+{
+    return m_tex_id;
+}
+
+bool GLTexture3D::isValid() const
+{
+    return m_tex_id != 0;
+}
+
+int GLTexture3D::getWidth() const
+{
+    return m_width;
+}
+
+int GLTexture3D::getHeight() const
+{
+    return m_height;
+}
+
+int GLTexture3D::getDepth() const
+{
+    return m_depth;
+}
+
+GLint GLTexture3D::getInternalFormat() const
+{
+    return m_internal_format;
+}
+
+}//end of namespace luna
@@ -0,0 +1,83 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl 3d texture, e.g. 3d color lookup table
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "gl_include.h"
+
+namespace luna {
+
+//NOTE: storage is immutable (glTexStorage3D, glTexImage3D on macOS) and sampled trilinearly by default,
+//      use a filterable format on OpenGLES, i.e. GL_RGB16F/GL_RGBA16F/GL_RGBA8 (32F is not filterable).
+
+class GLTexture3D
+{
+public:
+
+    GLTexture3D() = default;
+
+    GLTexture3D(int width, int height, int depth, GLint internal_format = GL_RGB16F);
+
+    //allocate storage, contents are undefined
+    bool init(int width, int height, int depth, GLint internal_format = GL_RGB16F);
+
+    ~GLTexture3D();
+
+    void destroy();
+
+    //disable copy
+    GLTexture3D(const GLTexture3D& rhs) = delete;
+    GLTexture3D& operator = (const GLTexture3D& rhs) = delete;
+
+    //enable move
+    GLTexture3D(GLTexture3D&& rhs) noexcept;
+    GLTexture3D& operator = (GLTexture3D&& rhs) noexcept;
+
+    //-----------
+
+    //upload the whole volume, x is the fastest varying index, then y, then z
+    bool update(const float* data, GLenum format = GL_RGB);
+
+    bool update(const unsigned char* data, GLenum format = GL_RGB);
+
+    void setFilter(GLenum min_filter, GLenum mag_filter);
+
+    void setWrapMode(GLenum wrap_s, GLenum wrap_t, GLenum wrap_r);
+
+    void bind() const;
+
+    void bind(GLuint tex_unit) const;
+
+    void unbind() const;
+
+    GLuint id() const;
+
+    bool isValid() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    int getDepth() const;
+
+    GLint getInternalFormat() const;
+
+private:
+
+    bool updateTextureData(const void* data, GLenum format, GLenum type);
+
+private:
+    GLuint m_tex_id = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_depth = 0;
+
+    GLint m_internal_format = 0;
+};
+
+}//end of namespace luna
@@ -0,0 +1,308 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl 2d texture array, i.e. N layers of the same size & format bound as one texture
+ * @version    : 1.0
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_texture_streamer.h"
+
+#include "gl_texture_array.h"
+
+namespace luna {
+
+GLTextureArray::GLTextureArray(int width, int height, int layer_num, GLint internal_format)
+{
+    bool succ = this->init(width, height, layer_num, internal_format);
+    if (!succ)
+    {
+        LOGE("error: can not init GLTextureArray");
+        throw std::invalid_argument("error: can not init GLTextureArray");
+    }
+}
+
+bool GLTextureArray::init(int width, int height, int layer_num, GLint internal_format)
+{
+    if (width <= 0 || height <= 0 || layer_num <= 0)
+    {
+        LOGE("error: invalid texture array size: %d x %d x %d", width, height, layer_num);
+        throw std::invalid_argument("error: invalid texture array size");
+        return false;
+    }
+
+    GLint MAX_ARRAY_TEXTURE_LAYERS = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &MAX_ARRAY_TEXTURE_LAYERS);
+
+    if (layer_num > MAX_ARRAY_TEXTURE_LAYERS)
+    {
+        LOGE("error: layer num(%d) exceeds GL_MAX_ARRAY_TEXTURE_LAYERS(%d)", layer_num, MAX_ARRAY_TEXTURE_LAYERS);
+        throw std::invalid_argument("error: layer num exceeds GL_MAX_ARRAY_TEXTURE_LAYERS");
+        return false;
+    }
+
+    //destroy if necessary
+    this->destroy();
+
+    m_width = width;
+    m_height = height;
+    m_layer_num = layer_num;
+    m_internal_format = GLTexture::getSizedInternalFormat(internal_format);
+
+    this->resetFrames();
+
+    glVerify(glGenTextures(1, &m_tex_id));
+    glVerify(glBindTexture(GL_TEXTURE_2D_ARRAY, m_tex_id));
+
+#if __MACOS__
+    //NOTE: macOS only supports OpenGL 4.1, glTexStorage3D (4.2) is not available
+    GLenum format = GL_RGBA;
+    GLenum type = GL_UNSIGNED_BYTE;
+    GLTexture::getFormatAndType(m_internal_format, format, type);
+
+    glVerify(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, m_internal_format, m_width, m_height, m_layer_num, 0, format, type, nullptr));
+#else
+    glVerify(glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, m_internal_format, m_width, m_height, m_layer_num));
+#endif
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glVerify(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+    return true;
+}
+
+GLTextureArray::~GLTextureArray()
+{
+    this->destroy();
+}
+
+void GLTextureArray::destroy()
+{
+    if (m_tex_id != 0)
+    {
+        glDeleteTextures(1, &m_tex_id);
+        m_tex_id = 0;
+
+        m_width = 0;
+        m_height = 0;
+        m_layer_num = 0;
+        m_internal_format = 0;
+        m_bgr_storage = false;
+    }
+
+    m_streamer.reset();
+
+    this->resetFrames();
+}
+
+GLTextureArray::GLTextureArray(GLTextureArray&& rhs) noexcept
+{
+    m_tex_id = rhs.m_tex_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_layer_num = rhs.m_layer_num;
+    m_internal_format = rhs.m_internal_format;
+    m_bgr_storage = rhs.m_bgr_storage;
+    m_streamer = std::move(rhs.m_streamer);
+    m_newest_layer = rhs.m_newest_layer;
+    m_frame_num = rhs.m_frame_num;
+
+    rhs.m_tex_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_layer_num = 0;
+    rhs.m_internal_format = 0;
+    rhs.m_bgr_storage = false;
+    rhs.resetFrames();
+}
+
+GLTextureArray& GLTextureArray::operator = (GLTextureArray&& rhs) noexcept
+{
+    if (this == &rhs)
+        return *this;
+
+    this->destroy();
+
+    m_tex_id = rhs.m_tex_id;
+    m_width = rhs.m_width;
+    m_height = rhs.m_height;
+    m_layer_num = rhs.m_layer_num;
+    m_internal_format = rhs.m_internal_format;
+    m_bgr_storage = rhs.m_bgr_storage;
+    m_streamer = std::move(rhs.m_streamer);
+    m_newest_layer = rhs.m_newest_layer;
+    m_frame_num = rhs.m_frame_num;
+
+    rhs.m_tex_id = 0;
+    rhs.m_width = 0;
+    rhs.m_height = 0;
+    rhs.m_layer_num = 0;
+    rhs.m_internal_format = 0;
+    rhs.m_bgr_storage = false;
+    rhs.resetFrames();
+
+    return *this;
+}
+
+bool GLTextureArray::updateLayer(int layer, const cv::Mat& img, GLenum format)
+{
+    if (m_tex_id == 0)
+    {
+        LOGE("error: invalid texture id: %d", m_tex_id);
+        throw std::invalid_argument("error: invalid texture id");
+        return false;
+    }
+
+    if (img.empty() || img.cols != m_width || img.rows != m_height)
+    {
+        LOGE("error: image size (%d x %d) not match texture array size (%d x %d)", img.cols, img.rows, m_width, m_height);
+        throw std::invalid_argument("error: image size not match texture array size");
+        return false;
+    }
+
+    GLTexture::checkChannelNum(img, format);
+
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    const GLenum type = (img.depth() == CV_32F) ? GL_FLOAT : GL_UNSIGNED_BYTE;
+
+    //NOTE: PBOs of the ring are sized for one layer, i.e. the streamer only changes with the upload format
+    if (!m_streamer || m_streamer->getFormat() != format || m_streamer->getType() != type)
+        m_streamer = std::make_unique<GLTextureStreamer>(m_width, m_height, format, type);
+
+    return m_streamer->update(img, *this, layer);
+}
+
+int GLTextureArray::pushFrame(const cv::Mat& img, GLenum format)
+{
+    if (m_layer_num <= 0)
+    {
+        LOGE("error: texture array is not initialized");
+        throw std::runtime_error("error: texture array is not initialized");
+        return -1;
+    }
+
+    const int layer = (m_newest_layer + 1) % m_layer_num;
+
+    bool succ = this->updateLayer(layer, img, format);
+    if (!succ)
+        return -1;
+
+    m_newest_layer = layer;
+    m_frame_num = std::min(m_frame_num + 1, m_layer_num);
+
+    return m_newest_layer;
+}
+
+int GLTextureArray::getFrameLayer(int age) const
+{
+    if (age < 0 || age >= m_frame_num)
+        return -1;
+
+    return (m_newest_layer - age + m_layer_num) % m_layer_num;
+}
+
+int GLTextureArray::getFrameNum() const
+{
+    return m_frame_num;
+}
+
+void GLTextureArray::resetFrames()
+{
+    m_newest_layer = -1;
+    m_frame_num = 0;
+}
+
+void GLTextureArray::setFilter(GLenum min_filter, GLenum mag_filter)
+{
+    this->bind();
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, min_filter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, mag_filter);
+    this->unbind();
+}
+
+void GLTextureArray::setWrapMode(GLenum wrap_s, GLenum wrap_t)
+{
+    this->bind();
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrap_s);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrap_t);
+    this->unbind();
+}
+
+void GLTextureArray::bind() const
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_tex_id);
+}
+
+void GLTextureArray::bind(GLuint tex_unit) const
+{
+    glActiveTexture(tex_unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_tex_id);
+}
+
+void GLTextureArray::unbind() const
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+GLuint GLTextureArray::id() const
+{
+    return m_tex_id;
+}
+
+bool GLTextureArray::isValid() const
+{
+    return m_tex_id != 0;
+}
+
+int GLTextureArray::getWidth() const
+{
+    return m_width;
+}
+
+int GLTextureArray::getHeight() const
+{
+    return m_height;
+}
+
+int GLTextureArray::getLayerNum() const
+{
+    return m_layer_num;
+}
+
+GLint GLTextureArray::getInternalFormat() const
+{
+    return m_internal_format;
+}
+
+bool GLTextureArray::isBGRStorage() const
+{
+    return m_bgr_storage;
+}
+
+void GLTextureArray::setBGRStorage(bool bgr_storage)
+{
+    m_bgr_storage = bgr_storage;
+
+    this->bind();
+    glVerify(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_R, bgr_storage ? GL_BLUE : GL_RED));
+    glVerify(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, bgr_storage ? GL_RED : GL_BLUE));
+    this->unbind();
+}
+
+}//end of namespace luna
@@ -0,0 +1,116 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: opengl 2d texture array, i.e. N layers of the same size & format bound as one texture
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+namespace luna {
+
+class GLTextureStreamer;
+
+//NOTE: layers are sampled by sampler2DArray with vec3(uv, layer) and can be rendered all at once
+//      by a layered GLFrameBuffer (gl_Layer), see GLLayeredPass.
+//      Burst / temporal algorithms bind N frames as one texture (one unit, one bind), and pushFrame() keeps
+//      the last N frames as a ring, i.e. advancing to the next frame uploads only one layer:
+//
+//                    int newest = frames.pushFrame(camera_frame, GL_BGR);
+//                    shader.setTexture("u_frames", frames);
+//                    shader.setInt("u_newest", newest);  //frame of age k: layer (u_newest - k + N) % N
+
+class GLTextureArray
+{
+public:
+
+    GLTextureArray() = default;
+
+    GLTextureArray(int width, int height, int layer_num, GLint internal_format = GL_RGBA8);
+
+    //allocate storage of layer_num layers, contents are undefined
+    bool init(int width, int height, int layer_num, GLint internal_format = GL_RGBA8);
+
+    ~GLTextureArray();
+
+    void destroy();
+
+    //disable copy
+    GLTextureArray(const GLTextureArray& rhs) = delete;
+    GLTextureArray& operator = (const GLTextureArray& rhs) = delete;
+
+    //enable move
+    GLTextureArray(GLTextureArray&& rhs) noexcept;
+    GLTextureArray& operator = (GLTextureArray&& rhs) noexcept;
+
+    //-----------
+
+    //upload img (u8 or float, array size) into layer through a PBO ring (GLTextureStreamer),
+    //i.e. the copy into the driver is asynchronous, rows are uploaded as is (no vertical flip)
+    bool updateLayer(int layer, const cv::Mat& img, GLenum format = GL_RGB);
+
+    //upload img into the oldest layer of the ring and make it the newest, returns its layer
+    int pushFrame(const cv::Mat& img, GLenum format = GL_RGB);
+
+    //layer of the frame pushed age frames ago (0: newest), -1 if there is no such frame yet
+    int getFrameLayer(int age = 0) const;
+
+    //frames kept by the ring, <= getLayerNum()
+    int getFrameNum() const;
+
+    //forget pushed frames, storage is kept
+    void resetFrames();
+
+    void setFilter(GLenum min_filter, GLenum mag_filter);
+
+    void setWrapMode(GLenum wrap_s, GLenum wrap_t);
+
+    void bind() const;
+
+    void bind(GLuint tex_unit) const;
+
+    void unbind() const;
+
+    GLuint id() const;
+
+    bool isValid() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    int getLayerNum() const;
+
+    GLint getInternalFormat() const;
+
+    //true if storage holds BGR(A) uploaded as is, red and blue are swapped back by texture swizzle (all layers)
+    bool isBGRStorage() const;
+
+    void setBGRStorage(bool bgr_storage);
+
+private:
+    GLuint m_tex_id = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_layer_num = 0;
+
+    GLint m_internal_format = 0;
+
+    bool m_bgr_storage = false;
+
+    //created on first updateLayer(), re-created if the upload format changes
+    std::unique_ptr<GLTextureStreamer> m_streamer;
+
+    //ring of pushed frames
+    int m_newest_layer = -1;
+    int m_frame_num = 0;
+};
+
+}//end of namespace luna
@@ -73,6 +73,16 @@ GLTextureCubeMap::GLTextureCubeMap(const std::vector<std::string>& image_files)
     }
 }
 
+GLTextureCubeMap::GLTextureCubeMap(int size, GLint internal_format)
+{
+    bool succ = this->init(size, internal_format);
+    if (!succ)
+    {
+        LOGE("error: can not init GLTextureCubeMap");
+        throw std::invalid_argument("error: can not init GLTextureCubeMap");
+    }
+}
+
 void GLTextureCubeMap::setupTexture()
 {
     glGenTextures(1, &m_tex_id);
@@ -108,6 +118,8 @@ bool GLTextureCubeMap::updateTextureData(int width, int height, GLenum target, G
 
     GLint internal_format = GLTexture::getInternalFormat(format, std::is_same_v<Scale, float>);
 
+    m_size = width;
+    m_internal_format = internal_format;
 
     if constexpr (std::is_same_v<Scale, unsigned char>)
     {
@@ -283,6 +295,44 @@ bool GLTextureCubeMap::init(const cv::Mat & positive_x_img,
     return true;
 }
 
+bool GLTextureCubeMap::init(int size, GLint internal_format)
+{
+    if (size <= 0)
+    {
+        LOGE("error: invalid cubemap size: %d", size);
+        throw std::invalid_argument("error: invalid cubemap size");
+        return false;
+    }
+
+    //destroy if necessary
+    this->destroy();
+
+    setupTexture();
+
+    m_size = size;
+    m_internal_format = GLTexture::getSizedInternalFormat(internal_format);
+
+    this->bind();
+
+#if __MACOS__
+    //NOTE: macOS only supports OpenGL 4.1, glTexStorage2D (4.2) is not available
+    GLenum format = GL_RGBA;
+    GLenum type = GL_UNSIGNED_BYTE;
+    GLTexture::getFormatAndType(m_internal_format, format, type);
+
+    for (int i = 0; i < 6; ++i)
+        glVerify(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, m_internal_format, m_size, m_size, 0, format, type, nullptr));
+#else
+    glVerify(glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, m_internal_format, m_size, m_size));
+#endif
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+
+    this->unbind();
+
+    return true;
+}
+
 GLTextureCubeMap::~GLTextureCubeMap()
 {
     destroy();
@@ -294,6 +344,9 @@ void GLTextureCubeMap::destroy()
     {
         glDeleteTextures(1, &m_tex_id);
         m_tex_id = 0;
+
+        m_size = 0;
+        m_internal_format = 0;
     }
 }
 
@@ -301,7 +354,12 @@ void GLTextureCubeMap::destroy()
 GLTextureCubeMap::GLTextureCubeMap(GLTextureCubeMap&& rhs) noexcept
 {
     m_tex_id = rhs.m_tex_id;
+    m_size = rhs.m_size;
+    m_internal_format = rhs.m_internal_format;
+
     rhs.m_tex_id = 0;
+    rhs.m_size = 0;
+    rhs.m_internal_format = 0;
 }
 
 GLTextureCubeMap& GLTextureCubeMap::operator = (GLTextureCubeMap&& rhs) noexcept
@@ -311,7 +369,12 @@ GLTextureCubeMap& GLTextureCubeMap::operator = (GLTextureCubeMap&& rhs) noexcept
         this->destroy();
 
         m_tex_id = rhs.m_tex_id;
+        m_size = rhs.m_size;
+        m_internal_format = rhs.m_internal_format;
+
         rhs.m_tex_id = 0;
+        rhs.m_size = 0;
+        rhs.m_internal_format = 0;
     }
 
     return *this;
@@ -343,4 +406,14 @@ bool GLTextureCubeMap::isValid() const
     return m_tex_id != 0;
 }
 
+int GLTextureCubeMap::getSize() const
+{
+    return m_size;
+}
+
+GLint GLTextureCubeMap::getInternalFormat() const
+{
+    return m_internal_format;
+}
+
 }//end of namespace luna
\ No newline at end of file
@@ -38,6 +38,8 @@
 
     GLTextureCubeMap(const std::vector<std::string>& image_files);
 
+    GLTextureCubeMap(int size, GLint internal_format);
+
     bool init(const std::string& positive_x_image_file,
               const std::string& negative_x_image_file,
               const std::string& positive_y_image_file,
@@ -55,6 +57,9 @@
 
     bool init(const std::vector<std::string>& image_files);
 
+    //allocate 6 empty size x size faces, e.g. render target of a layered GLFrameBuffer (environment map)
+    bool init(int size, GLint internal_format = GL_RGBA8);
+
     ~GLTextureCubeMap();
 
     void destroy();
@@ -79,6 +84,9 @@
 
     bool isValid() const;
 
+    int getSize() const; //width (== height) of each face
+
+    GLint getInternalFormat() const;
 
  private:
     void setupTexture();
@@ -88,6 +96,10 @@
 
 private:
     GLuint m_tex_id = 0;
+
+    int m_size = 0;
+
+    GLint m_internal_format = 0;
  };
 
  }//end of namespace luna
@@ -0,0 +1,403 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: asynchronous texture upload by PBO ring
+ * @version    : 1.0
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_texture_array.h"
+
+#include "gl_texture_streamer.h"
+
+namespace luna {
+
+GLTextureStreamer::GLTextureStreamer(int width, int height, GLenum format, GLenum type, int ring_size)
+{
+    bool succ = this->init(width, height, format, type, ring_size);
+    if (!succ)
+    {
+        LOGE("error: can not init GLTextureStreamer");
+        throw std::invalid_argument("error: can not init GLTextureStreamer");
+    }
+}
+
+bool GLTextureStreamer::init(int width, int height, GLenum format, GLenum type, int ring_size)
+{
+    //destroy if necessary
+    this->destroy();
+
+    if (width <= 0 || height <= 0 || ring_size <= 0)
+    {
+        LOGE("error: invalid streamer size, width: %d, height: %d, ring_size: %d", width, height, ring_size);
+        throw std::invalid_argument("error: invalid streamer size");
+        return false;
+    }
+
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    if (getStorageFormat(format, type) == 0)
+    {
+        LOGE("error: unsupported streamer format 0x%x & type 0x%x", format, type);
+        throw std::invalid_argument("error: unsupported streamer format & type");
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_format = format;
+    m_type = type;
+
+    m_row_bytes = m_width * GLTexture::getChannelNum(m_format) * getTypeSize(m_type);
+
+    m_ring.resize(ring_size);
+    for (RingBuffer& buffer : m_ring)
+        buffer.pbo.update(nullptr, m_row_bytes * m_height, GL_STREAM_DRAW);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_next_slot = 0;
+
+    return true;
+}
+
+GLTextureStreamer::~GLTextureStreamer()
+{
+    this->destroy();
+}
+
+void GLTextureStreamer::destroy()
+{
+    m_ring.clear();
+
+    m_next_slot = 0;
+
+    m_width = 0;
+    m_height = 0;
+    m_row_bytes = 0;
+}
+
+GLTextureStreamer::Slot GLTextureStreamer::acquire()
+{
+    Slot slot;
+
+    if (m_ring.empty())
+    {
+        LOGE("error: GLTextureStreamer is not initialized");
+        throw std::runtime_error("error: GLTextureStreamer is not initialized");
+    }
+
+    RingBuffer& buffer = m_ring[m_next_slot];
+
+    if (buffer.state == SlotState::MAPPED)
+    {
+        LOGE("error: all slots are being written, commit() some slots first");
+        return slot;
+    }
+
+    //wait until GPU finishes reading this PBO (uploaded ring_size frames ago), usually already signaled
+    buffer.fence.wait();
+    buffer.fence.destroy();
+
+    //NOTE: fence guarantees GPU is done, so unsynchronized mapping is safe and avoids driver stall
+    void* ptr = buffer.pbo.map(GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    buffer.pbo.unbind();
+
+    if (ptr == nullptr)
+        return slot;
+
+    buffer.state = SlotState::MAPPED;
+
+    slot.index = m_next_slot;
+    slot.data = ptr;
+    slot.step = m_row_bytes;
+    slot.width = m_width;
+    slot.height = m_height;
+
+    m_next_slot = (m_next_slot + 1) % static_cast<int>(m_ring.size());
+
+    return slot;
+}
+
+bool GLTextureStreamer::unmapSlot(const Slot& slot)
+{
+    if (slot.index < 0 || slot.index >= static_cast<int>(m_ring.size()))
+    {
+        LOGE("error: invalid slot index: %d", slot.index);
+        throw std::invalid_argument("error: invalid slot index");
+        return false;
+    }
+
+    RingBuffer& buffer = m_ring[slot.index];
+
+    if (buffer.state != SlotState::MAPPED)
+    {
+        LOGE("error: slot %d is not acquired", slot.index);
+        throw std::invalid_argument("error: slot is not acquired");
+        return false;
+    }
+
+    buffer.state = SlotState::FREE;
+
+    bool succ = buffer.pbo.unmap();
+    if (!succ)
+    {
+        //contents are lost, skip this frame
+        LOGE("error: pixel buffer contents corrupted, frame dropped");
+        buffer.pbo.unbind();
+        return false;
+    }
+
+    return true;
+}
+
+bool GLTextureStreamer::commit(const Slot& slot, GLTexture& tex)
+{
+    if (!this->unmapSlot(slot))
+        return false;
+
+    RingBuffer& buffer = m_ring[slot.index];
+
+    if (tex.getMultiSample() > 1)
+    {
+        LOGE("error: can not upload to multi-sample texture");
+        throw std::invalid_argument("error: can not upload to multi-sample texture");
+        return false;
+    }
+
+    //keep explicitly allocated storage (e.g. GL_RGBA16F) as long as data can be converted into it
+    const bool format_match = this->isStorageCompatible(tex.getInternalFormat());
+
+    if (!tex.isValid() || tex.getWidth() != m_width || tex.getHeight() != m_height || !format_match)
+        tex.allocate(m_width, m_height, getStorageFormat(m_format, m_type));
+
+    //BGR(A) is uploaded as RGB(A), red and blue are swapped back by texture swizzle
+    const bool bgr_storage = (m_format == GL_BGR || m_format == GL_BGRA);
+    const GLenum upload_format = GLTexture::getUploadFormat(m_format);
+
+    if (tex.isBGRStorage() != bgr_storage)
+        tex.setBGRStorage(bgr_storage);
+
+    buffer.pbo.bind();
+    tex.bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    //data pointer is an offset into the bound GL_PIXEL_UNPACK_BUFFER, i.e. asynchronous DMA copy
+    glVerify(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, upload_format, m_type, nullptr));
+
+    tex.unbind();
+    buffer.pbo.unbind();
+
+    tex.markContentsChanged();
+
+    buffer.fence.insert();
+
+    return true;
+}
+
+bool GLTextureStreamer::commit(const Slot& slot, GLTextureArray& tex_array, int layer)
+{
+    if (!this->unmapSlot(slot))
+        return false;
+
+    RingBuffer& buffer = m_ring[slot.index];
+
+    if (layer < 0 || layer >= tex_array.getLayerNum())
+    {
+        LOGE("error: invalid layer: %d, layer num: %d", layer, tex_array.getLayerNum());
+        throw std::invalid_argument("error: invalid layer");
+        return false;
+    }
+
+    if (tex_array.getWidth() != m_width || tex_array.getHeight() != m_height ||
+        !this->isStorageCompatible(tex_array.getInternalFormat()))
+    {
+        LOGE("error: texture array (%d x %d) does not match streamer (%d x %d) or its format", tex_array.getWidth(), tex_array.getHeight(), m_width, m_height);
+        throw std::invalid_argument("error: texture array does not match streamer");
+        return false;
+    }
+
+    //BGR(A) is uploaded as RGB(A), swizzle is per texture, i.e. all layers share it
+    const bool bgr_storage = (m_format == GL_BGR || m_format == GL_BGRA);
+    const GLenum upload_format = GLTexture::getUploadFormat(m_format);
+
+    if (tex_array.isBGRStorage() != bgr_storage)
+        tex_array.setBGRStorage(bgr_storage);
+
+    buffer.pbo.bind();
+    tex_array.bind();
+
+    glVerify(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    glVerify(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_width, m_height, 1, upload_format, m_type, nullptr));
+
+    tex_array.unbind();
+    buffer.pbo.unbind();
+
+    buffer.fence.insert();
+
+    return true;
+}
+
+GLTextureStreamer::Slot GLTextureStreamer::write(const cv::Mat& img)
+{
+    if (img.cols != m_width || img.rows != m_height)
+    {
+        LOGE("error: image size (%d x %d) not match streamer size (%d x %d)", img.cols, img.rows, m_width, m_height);
+        throw std::invalid_argument("error: image size not match streamer size");
+    }
+
+    const int img_row_bytes = img.cols * static_cast<int>(img.elemSize());
+    if (img_row_bytes != m_row_bytes)
+    {
+        LOGE("error: image pixel size not match streamer format");
+        throw std::invalid_argument("error: image pixel size not match streamer format");
+    }
+
+    Slot slot = this->acquire();
+    if (!slot.isValid())
+        return slot;
+
+    unsigned char* dst = static_cast<unsigned char*>(slot.data);
+
+    if (img.isContinuous())
+    {
+        std::memcpy(dst, img.data, static_cast<size_t>(m_row_bytes) * m_height);
+    }
+    else
+    {
+        for (int row = 0; row < m_height; ++row)
+            std::memcpy(dst + static_cast<size_t>(row) * slot.step, img.ptr(row), m_row_bytes);
+    }
+
+    return slot;
+}
+
+bool GLTextureStreamer::update(const cv::Mat& img, GLTexture& tex)
+{
+    Slot slot = this->write(img);
+    if (!slot.isValid())
+        return false;
+
+    return this->commit(slot, tex);
+}
+
+bool GLTextureStreamer::update(const cv::Mat& img, GLTextureArray& tex_array, int layer)
+{
+    Slot slot = this->write(img);
+    if (!slot.isValid())
+        return false;
+
+    return this->commit(slot, tex_array, layer);
+}
+
+int GLTextureStreamer::getWidth() const
+{
+    return m_width;
+}
+
+int GLTextureStreamer::getHeight() const
+{
+    return m_height;
+}
+
+GLenum GLTextureStreamer::getFormat() const
+{
+    return m_format;
+}
+
+GLenum GLTextureStreamer::getType() const
+{
+    return m_type;
+}
+
+int GLTextureStreamer::getRingSize() const
+{
+    return static_cast<int>(m_ring.size());
+}
+
+bool GLTextureStreamer::isValid() const
+{
+    return !m_ring.empty();
+}
+
+int GLTextureStreamer::getTypeSize(GLenum type)
+{
+    if (type == GL_UNSIGNED_BYTE || type == GL_BYTE)
+        return 1;
+    if (type == GL_UNSIGNED_SHORT || type == GL_SHORT || type == GL_HALF_FLOAT)
+        return 2;
+    if (type == GL_UNSIGNED_INT || type == GL_INT || type == GL_FLOAT)
+        return 4;
+
+    throw std::invalid_argument("error: unsupported data type");
+}
+
+GLint GLTextureStreamer::getStorageFormat(GLenum format, GLenum type)
+{
+    //for compatibility
+    if (format == GL_LUMINANCE)
+        format = GL_RED;
+
+    const GLenum upload_format = GLTexture::getUploadFormat(format);
+
+    if (upload_format != GL_RED && upload_format != GL_RG && upload_format != GL_RGB && upload_format != GL_RGBA)
+        return 0;
+
+    if (type == GL_UNSIGNED_BYTE || type == GL_FLOAT)
+        return GLTexture::getSizedInternalFormat(GLTexture::getInternalFormat(upload_format, type == GL_FLOAT));
+
+    if (type == GL_HALF_FLOAT)
+    {
+        if (upload_format == GL_RED)
+            return GL_R16F;
+        if (upload_format == GL_RG)
+            return GL_RG16F;
+        if (upload_format == GL_RGB)
+            return GL_RGB16F;
+        return GL_RGBA16F;
+    }
+
+#if WIN32 || __MACOS__
+    //NOTE: 16-bit normalized formats are desktop only, and there is no GL_RGB16 storage here
+    if (type == GL_UNSIGNED_SHORT)
+    {
+        if (upload_format == GL_RED)
+            return GL_R16;
+        if (upload_format == GL_RG)
+            return GL_RG16;
+        if (upload_format == GL_RGBA)
+            return GL_RGBA16;
+    }
+#endif
+
+    return 0;
+}
+
+bool GLTextureStreamer::isStorageCompatible(GLint internal_format) const
+{
+    if (internal_format == getStorageFormat(m_format, m_type))
+        return true;
+
+    if (m_type == GL_UNSIGNED_BYTE || m_type == GL_FLOAT)
+        return GLTexture::isUploadCompatible(internal_format, m_format, m_type == GL_FLOAT);
+
+    //half-float & 16-bit data: storage of the same type & channel num only
+    GLenum storage_format = GL_RGBA;
+    GLenum storage_type = GL_UNSIGNED_BYTE;
+    if (!GLTexture::queryFormatAndType(internal_format, storage_format, storage_type))
+        return false;
+
+    return storage_type == m_type && GLTexture::getChannelNum(storage_format) == GLTexture::getChannelNum(GLTexture::getUploadFormat(m_format));
+}
+
+}//end of namespace luna
@@ -0,0 +1,147 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: asynchronous texture upload by PBO ring
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+#include "gl_pixel_buffer.h"
+#include "gl_fence.h"
+
+namespace luna {
+
+class GLTexture;
+class GLTextureArray;
+
+//NOTE: typical usage for video/camera streaming:
+//
+//    //render thread
+//    GLTextureStreamer::Slot slot = streamer.acquire();
+//
+//    //decode thread (or render thread), write frame into slot.data, row stride is slot.step
+//    decoder.decodeTo(slot.data, slot.step);
+//
+//    //render thread, once frame is written
+//    streamer.commit(slot, texture);
+//
+//    acquire() only blocks if the GPU is still consuming the slot uploaded ring_size frames ago,
+//    commit() only enqueues a DMA copy from PBO to texture, i.e. render thread never memcpy into the driver.
+//    All GL calls (acquire/commit) must be issued on the thread owning the GL context.
+
+class GLTextureStreamer
+{
+public:
+
+    struct Slot
+    {
+        int index = -1;
+
+        void* data = nullptr; //mapped PBO memory, valid until commit()
+
+        int step = 0;         //row stride in bytes
+
+        int width = 0;
+        int height = 0;
+
+        bool isValid() const { return index >= 0 && data != nullptr; }
+    };
+
+    GLTextureStreamer() = default;
+
+    GLTextureStreamer(int width, int height, GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE, int ring_size = 3);
+
+    bool init(int width, int height, GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE, int ring_size = 3);
+
+    ~GLTextureStreamer();
+
+    void destroy();
+
+    //disable copy
+    GLTextureStreamer(const GLTextureStreamer& rhs) = delete;
+    GLTextureStreamer& operator = (const GLTextureStreamer& rhs) = delete;
+
+    //enable move
+    GLTextureStreamer(GLTextureStreamer&& rhs) noexcept = default;
+    GLTextureStreamer& operator = (GLTextureStreamer&& rhs) noexcept = default;
+
+    //-----------
+
+    //map next PBO of the ring for CPU writing
+    Slot acquire();
+
+    //unmap PBO and enqueue upload (glTexSubImage2D from PBO) into tex, storage of tex is (re)allocated if necessary
+    bool commit(const Slot& slot, GLTexture& tex);
+
+    //unmap PBO and enqueue upload (glTexSubImage3D from PBO) into one layer of tex_array,
+    //storage of tex_array is never reallocated, i.e. size & format must match
+    bool commit(const Slot& slot, GLTextureArray& tex_array, int layer);
+
+    //convenience: acquire + copy img (honoring img.step) + commit
+    bool update(const cv::Mat& img, GLTexture& tex);
+
+    bool update(const cv::Mat& img, GLTextureArray& tex_array, int layer);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    GLenum getFormat() const;
+
+    GLenum getType() const;
+
+    int getRingSize() const;
+
+    bool isValid() const;
+
+    static int getTypeSize(GLenum type);
+
+    //sized internal format a commit allocates for data of format & type, 0 if not supported,
+    //i.e. GL_UNSIGNED_BYTE -> *8, GL_HALF_FLOAT -> *16F, GL_FLOAT -> *32F, GL_UNSIGNED_SHORT -> *16 (desktop only, no rgb)
+    static GLint getStorageFormat(GLenum format, GLenum type);
+
+private:
+
+    //true if slots can be uploaded into storage of internal_format
+    bool isStorageCompatible(GLint internal_format) const;
+
+    //acquire a slot and copy img into it
+    Slot write(const cv::Mat& img);
+
+    //validate & unmap an acquired slot, false if its contents are lost
+    bool unmapSlot(const Slot& slot);
+
+    enum class SlotState
+    {
+        FREE,       //!< ready to be mapped (GPU may still read it, guarded by fence)
+        MAPPED,     //!< mapped, CPU is writing
+    };
+
+    struct RingBuffer
+    {
+        GLPixelBuffer pbo = GLPixelBuffer(GL_PIXEL_UNPACK_BUFFER);
+        GLFence fence;
+        SlotState state = SlotState::FREE;
+    };
+
+    std::vector<RingBuffer> m_ring;
+
+    int m_next_slot = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+
+    GLenum m_format = GL_RGBA;
+    GLenum m_type = GL_UNSIGNED_BYTE;
+
+    int m_row_bytes = 0;
+};
+
+}//end of namespace luna
@@ -82,6 +82,32 @@ inline void glAssert(const char* msg, long line, const char* file)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//restore GL_READ_FRAMEBUFFER/GL_DRAW_FRAMEBUFFER bindings on scope exit, i.e. a blit issued implicitly
+//(e.g. multi-sample resolve from getColorTex()) does not redirect the draws of an ongoing render pass
+class GLFrameBufferBindingGuard
+{
+public:
+    GLFrameBufferBindingGuard()
+    {
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_read_fbo_id);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_draw_fbo_id);
+    }
+
+    ~GLFrameBufferBindingGuard()
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_read_fbo_id);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_draw_fbo_id);
+    }
+
+    //disable copy
+    GLFrameBufferBindingGuard(const GLFrameBufferBindingGuard& rhs) = delete;
+    GLFrameBufferBindingGuard& operator = (const GLFrameBufferBindingGuard& rhs) = delete;
+
+private:
+    GLint m_read_fbo_id = 0;
+    GLint m_draw_fbo_id = 0;
+};
+
 inline int openGLGetCurBindShaderID()
 {
     GLint cur_program_id = 0;
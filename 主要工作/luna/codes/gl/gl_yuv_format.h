@@ -0,0 +1,95 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: yuv layouts & color conversion coefficients
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "glm/glm.hpp"
+
+namespace luna {
+
+enum class YUVFormat
+{
+    I420,   //!< Y plane, U plane (w/2 x h/2), V plane (w/2 x h/2)
+    NV12,   //!< Y plane, interleaved UV plane (w/2 x h/2)
+    NV21,   //!< Y plane, interleaved VU plane (w/2 x h/2), android camera default
+};
+
+enum class YUVColorSpace
+{
+    BT601_FULL,     //!< jpeg
+    BT601_LIMITED,  //!< SD video, most android/ios camera frames
+    BT709_FULL,
+    BT709_LIMITED,  //!< HD video
+};
+
+//rgb = matrix * (yuv - offset), all in normalized [0, 1]
+struct YUVToRGBCoeffs
+{
+    glm::mat3 matrix;
+    glm::vec3 offset;
+};
+
+inline YUVToRGBCoeffs getYUVToRGBCoeffs(YUVColorSpace color_space)
+{
+    const bool is_bt709 = (color_space == YUVColorSpace::BT709_FULL || color_space == YUVColorSpace::BT709_LIMITED);
+    const bool is_full_range = (color_space == YUVColorSpace::BT601_FULL || color_space == YUVColorSpace::BT709_FULL);
+
+    const float kr = is_bt709 ? 0.2126f : 0.299f;
+    const float kb = is_bt709 ? 0.0722f : 0.114f;
+    const float kg = 1.0f - kr - kb;
+
+    //limited range: y in [16, 235], uv in [16, 240]
+    const float y_scale = is_full_range ? 1.0f : 255.0f / 219.0f;
+    const float c_scale = is_full_range ? 1.0f : 255.0f / 224.0f;
+
+    YUVToRGBCoeffs coeffs;
+
+    //NOTE: glm matrix is column-major, i.e. matrix[col][row]
+    coeffs.matrix[0] = glm::vec3(y_scale, y_scale, y_scale);
+    coeffs.matrix[1] = glm::vec3(0.0f, -2.0f * kb * (1.0f - kb) / kg * c_scale, 2.0f * (1.0f - kb) * c_scale);
+    coeffs.matrix[2] = glm::vec3(2.0f * (1.0f - kr) * c_scale, -2.0f * kr * (1.0f - kr) / kg * c_scale, 0.0f);
+
+    coeffs.offset = glm::vec3(is_full_range ? 0.0f : 16.0f / 255.0f, 128.0f / 255.0f, 128.0f / 255.0f);
+
+    return coeffs;
+}
+
+//yuv = matrix * rgb + offset, all in normalized [0, 1]
+struct RGBToYUVCoeffs
+{
+    glm::mat3 matrix;
+    glm::vec3 offset;
+};
+
+inline RGBToYUVCoeffs getRGBToYUVCoeffs(YUVColorSpace color_space)
+{
+    const bool is_bt709 = (color_space == YUVColorSpace::BT709_FULL || color_space == YUVColorSpace::BT709_LIMITED);
+    const bool is_full_range = (color_space == YUVColorSpace::BT601_FULL || color_space == YUVColorSpace::BT709_FULL);
+
+    const float kr = is_bt709 ? 0.2126f : 0.299f;
+    const float kb = is_bt709 ? 0.0722f : 0.114f;
+    const float kg = 1.0f - kr - kb;
+
+    const float y_scale = is_full_range ? 1.0f : 219.0f / 255.0f;
+    const float c_scale = is_full_range ? 1.0f : 224.0f / 255.0f;
+
+    const float cb_scale = c_scale / (2.0f * (1.0f - kb));
+    const float cr_scale = c_scale / (2.0f * (1.0f - kr));
+
+    RGBToYUVCoeffs coeffs;
+
+    //NOTE: glm matrix is column-major, i.e. matrix[col][row]
+    coeffs.matrix[0] = glm::vec3(kr * y_scale, -kr * cb_scale, (1.0f - kr) * cr_scale);
+    coeffs.matrix[1] = glm::vec3(kg * y_scale, -kg * cb_scale, -kg * cr_scale);
+    coeffs.matrix[2] = glm::vec3(kb * y_scale, (1.0f - kb) * cb_scale, -kb * cr_scale);
+
+    coeffs.offset = glm::vec3(is_full_range ? 0.0f : 16.0f / 255.0f, 128.0f / 255.0f, 128.0f / 255.0f);
+
+    return coeffs;
+}
+
+}//end of namespace luna
@@ -0,0 +1,213 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: pack rgb into yuv (I420/NV12/NV21) on GPU before readback
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_texture.h"
+#include "gl_render_pass.h"
+
+#include "gl_yuv_packer.h"
+
+namespace luna {
+
+static const char* YUV_PACK_FRAGMENT_SHADER = R"(
+precision highp float;
+precision highp int;
+
+uniform sampler2D u_tex_rgb;
+uniform int u_yuv_format;       //0: I420, 1: NV12, 2: NV21
+uniform bool u_vertical_flip;
+uniform mat3 u_rgb_to_yuv_matrix;
+uniform vec3 u_rgb_to_yuv_offset;
+
+out vec4 frag_color;
+
+ivec2 g_src_size;
+
+vec3 fetchRGB(int x, int y)
+{
+    int row = u_vertical_flip ? (g_src_size.y - 1 - y) : y;
+    return texelFetch(u_tex_rgb, ivec2(x, row), 0).rgb;
+}
+
+float luma(int x, int y)
+{
+    return dot(vec3(u_rgb_to_yuv_matrix[0].x, u_rgb_to_yuv_matrix[1].x, u_rgb_to_yuv_matrix[2].x), fetchRGB(x, y)) + u_rgb_to_yuv_offset.x;
+}
+
+//(u, v) of chroma sample (cx, cy), averaged over the 2x2 block
+vec2 chroma(int cx, int cy)
+{
+    vec3 rgb = 0.25 * (fetchRGB(2 * cx, 2 * cy) + fetchRGB(2 * cx + 1, 2 * cy) +
+                       fetchRGB(2 * cx, 2 * cy + 1) + fetchRGB(2 * cx + 1, 2 * cy + 1));
+
+    return (u_rgb_to_yuv_matrix * rgb + u_rgb_to_yuv_offset).yz;
+}
+
+//byte at offset of the I420 chroma area, i.e. U plane followed by V plane
+float planarChroma(int offset)
+{
+    int chroma_width = g_src_size.x / 2;
+    int plane_size = chroma_width * (g_src_size.y / 2);
+
+    int plane = offset / plane_size;
+    int index = offset - plane * plane_size;
+
+    vec2 uv = chroma(index % chroma_width, index / chroma_width);
+    return plane == 0 ? uv.x : uv.y;
+}
+
+void main()
+{
+    g_src_size = textureSize(u_tex_rgb, 0);
+
+    //texel (x, y) of output holds bytes [4x, 4x + 3] of row y in the yuv buffer
+    ivec2 p = ivec2(gl_FragCoord.xy);
+
+    int width = g_src_size.x;
+    int height = g_src_size.y;
+
+    vec4 result;
+
+    if (p.y < height)
+    {
+        int x = 4 * p.x;
+        result = vec4(luma(x, p.y), luma(x + 1, p.y), luma(x + 2, p.y), luma(x + 3, p.y));
+    }
+    else if (u_yuv_format == 0)
+    {
+        int offset = (p.y - height) * width + 4 * p.x;
+        result = vec4(planarChroma(offset), planarChroma(offset + 1), planarChroma(offset + 2), planarChroma(offset + 3));
+    }
+    else
+    {
+        //one row of interleaved chroma is exactly one output row (w bytes)
+        int cy = p.y - height;
+        vec2 c0 = chroma(2 * p.x, cy);
+        vec2 c1 = chroma(2 * p.x + 1, cy);
+
+        result = (u_yuv_format == 1) ? vec4(c0.x, c0.y, c1.x, c1.y) : vec4(c0.y, c0.x, c1.y, c1.x);
+    }
+
+    frag_color = clamp(result, 0.0, 1.0);
+}
+)";
+
+bool GLYUVPacker::pack(const GLTexture& rgb, YUVFormat format, YUVColorSpace color_space, bool vertical_flip)
+{
+    if (!rgb.isValid())
+    {
+        LOGE("error: invalid rgb texture");
+        throw std::invalid_argument("error: invalid rgb texture");
+        return false;
+    }
+
+    if (rgb.getMultiSample() > 1)
+    {
+        LOGE("error: multi-sample texture should be resolved before packing");
+        throw std::invalid_argument("error: multi-sample texture should be resolved before packing");
+        return false;
+    }
+
+    const int width = rgb.getWidth();
+    const int height = rgb.getHeight();
+
+    if (width % 4 != 0 || height % 2 != 0)
+    {
+        LOGE("error: invalid size for yuv packing: %d x %d, width %% 4 and height %% 2 should be 0", width, height);
+        throw std::invalid_argument("error: invalid size for yuv packing");
+        return false;
+    }
+
+    if (width != m_width || height != m_height)
+    {
+        m_fbo.init(width / 4, height * 3 / 2);
+
+        m_width = width;
+        m_height = height;
+    }
+
+    m_format = format;
+
+    if (!m_pack_shader.isValid())
+        m_pack_shader.createFromString(GLFullScreenPass::getVertexShaderSource(), YUV_PACK_FRAGMENT_SHADER);
+
+    RGBToYUVCoeffs coeffs = getRGBToYUVCoeffs(color_space);
+
+    //every texel is overwritten
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::DONT_CARE;
+
+    m_fbo.beginRenderPass(render_pass);
+
+    m_pack_shader.use();
+    m_pack_shader.setTexture("u_tex_rgb", rgb);
+    m_pack_shader.setInt("u_yuv_format", static_cast<int>(format));
+    //rows of FLIP_TEXCOORD texture are already upside down
+    m_pack_shader.setBool("u_vertical_flip", vertical_flip != rgb.isVerticalFlipped());
+    m_pack_shader.setMat3("u_rgb_to_yuv_matrix", coeffs.matrix);
+    m_pack_shader.setVec3("u_rgb_to_yuv_offset", coeffs.offset);
+
+    m_fullscreen_pass.draw();
+
+    m_pack_shader.unUse();
+
+    m_fbo.endRenderPass();
+
+    return true;
+}
+
+bool GLYUVPacker::read(cv::Mat& yuv) const
+{
+    if (m_fbo.id() == 0)
+    {
+        LOGE("error: nothing packed, call pack() first");
+        throw std::runtime_error("error: nothing packed");
+        return false;
+    }
+
+    //(w / 4) RGBA texels per row == w bytes per row, i.e. the packed target is the yuv buffer itself
+    yuv.create(m_height * 3 / 2, m_width, CV_8UC1);
+
+    return m_fbo.read(yuv.data, GL_RGBA);
+}
+
+GLAsyncReadback GLYUVPacker::readAsync() const
+{
+    if (m_fbo.id() == 0)
+    {
+        LOGE("error: nothing packed, call pack() first");
+        throw std::runtime_error("error: nothing packed");
+    }
+
+    return m_fbo.readAsync(GL_RGBA, GL_UNSIGNED_BYTE);
+}
+
+int GLYUVPacker::getWidth() const
+{
+    return m_width;
+}
+
+int GLYUVPacker::getHeight() const
+{
+    return m_height;
+}
+
+YUVFormat GLYUVPacker::getFormat() const
+{
+    return m_format;
+}
+
+const GLFrameBuffer& GLYUVPacker::getFrameBuffer() const
+{
+    return m_fbo;
+}
+
+}//end of namespace luna
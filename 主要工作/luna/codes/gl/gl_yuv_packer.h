@@ -0,0 +1,80 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: pack rgb into yuv (I420/NV12/NV21) on GPU before readback
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+#include "gl_framebuffer.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+#include "gl_async_readback.h"
+#include "gl_yuv_format.h"
+
+namespace luna {
+
+class GLTexture;
+
+//NOTE: the packing pass renders the final encoder layout into an RGBA8 target of (w / 4) x (h * 3 / 2),
+//      i.e. every output texel holds 4 bytes of the yuv buffer: luma rows first, then chroma rows.
+//      the readback is 1.5 bytes per pixel (instead of 3), in the exact memory layout of I420/NV12/NV21,
+//      and uses GL_RGBA & GL_UNSIGNED_BYTE, which is guaranteed by opengl es.
+//      requirement: width % 4 == 0, height % 2 == 0.
+
+class GLYUVPacker
+{
+public:
+
+    GLYUVPacker() = default;
+
+    ~GLYUVPacker() = default;
+
+    //disable copy
+    GLYUVPacker(const GLYUVPacker& rhs) = delete;
+    GLYUVPacker& operator = (const GLYUVPacker& rhs) = delete;
+
+    //enable move
+    GLYUVPacker(GLYUVPacker&& rhs) noexcept = default;
+    GLYUVPacker& operator = (GLYUVPacker&& rhs) noexcept = default;
+
+    //-----------
+
+    //vertical_flip: output rows top-down (encoder convention) from an opengl bottom-up texture
+    bool pack(const GLTexture& rgb,
+              YUVFormat format = YUVFormat::I420,
+              YUVColorSpace color_space = YUVColorSpace::BT601_LIMITED,
+              bool vertical_flip = true);
+
+    //yuv: CV_8UC1, (height * 3 / 2) x width
+    bool read(cv::Mat& yuv) const;
+
+    //readback of packed target, map() returns CV_8UC4 (height * 3 / 2) x (width / 4), i.e. same bytes as read()
+    GLAsyncReadback readAsync() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    YUVFormat getFormat() const;
+
+    const GLFrameBuffer& getFrameBuffer() const;
+
+private:
+    GLFrameBuffer m_fbo;
+
+    GLShader m_pack_shader;
+    GLFullScreenPass m_fullscreen_pass;
+
+    int m_width = 0;
+    int m_height = 0;
+
+    YUVFormat m_format = YUVFormat::I420;
+};
+
+}//end of namespace luna
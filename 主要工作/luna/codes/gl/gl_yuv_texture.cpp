@@ -0,0 +1,268 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: yuv (I420/NV12/NV21) texture, converted to rgb on GPU
+ * @version    : 1.0
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "core/log/log.h"
+
+#include "gl_utility.h"
+#include "gl_framebuffer.h"
+#include "gl_render_pass.h"
+
+#include "gl_yuv_texture.h"
+
+namespace luna {
+
+static const char* YUV_SAMPLING_SHADER = R"(
+uniform sampler2D u_tex_y;
+uniform sampler2D u_tex_u;    //U plane for I420, UV plane for NV12/NV21
+uniform sampler2D u_tex_v;    //V plane for I420
+uniform int u_yuv_format;     //0: I420, 1: NV12, 2: NV21
+uniform mat3 u_yuv_matrix;
+uniform vec3 u_yuv_offset;
+
+vec3 sampleYUVToRGB(vec2 tex_coord)
+{
+    vec3 yuv;
+    yuv.x = texture(u_tex_y, tex_coord).r;
+
+    if (u_yuv_format == 0)
+    {
+        yuv.y = texture(u_tex_u, tex_coord).r;
+        yuv.z = texture(u_tex_v, tex_coord).r;
+    }
+    else if (u_yuv_format == 1)
+    {
+        yuv.yz = texture(u_tex_u, tex_coord).rg;
+    }
+    else
+    {
+        yuv.yz = texture(u_tex_u, tex_coord).gr;
+    }
+
+    return clamp(u_yuv_matrix * (yuv - u_yuv_offset), 0.0, 1.0);
+}
+)";
+
+static const char* YUV_CONVERT_FRAGMENT_SHADER_MAIN = R"(
+in vec2 v_tex_coord;
+out vec4 frag_color;
+
+void main()
+{
+    frag_color = vec4(sampleYUVToRGB(v_tex_coord), 1.0);
+}
+)";
+
+GLYUVTexture::GLYUVTexture(int width, int height, YUVFormat format, YUVColorSpace color_space)
+{
+    bool succ = this->init(width, height, format, color_space);
+    if (!succ)
+    {
+        LOGE("error: can not init GLYUVTexture");
+        throw std::invalid_argument("error: can not init GLYUVTexture");
+    }
+}
+
+bool GLYUVTexture::init(int width, int height, YUVFormat format, YUVColorSpace color_space)
+{
+    //destroy if necessary
+    this->destroy();
+
+    if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0)
+    {
+        LOGE("error: invalid yuv size: %d x %d, width & height should be positive & even", width, height);
+        throw std::invalid_argument("error: invalid yuv size");
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_format = format;
+    m_color_space = color_space;
+
+    m_tex_y.allocate(width, height, GL_R8);
+
+    if (format == YUVFormat::I420)
+    {
+        m_tex_u.allocate(width / 2, height / 2, GL_R8);
+        m_tex_v.allocate(width / 2, height / 2, GL_R8);
+    }
+    else
+    {
+        m_tex_u.allocate(width / 2, height / 2, GL_RG8);
+    }
+
+    return true;
+}
+
+void GLYUVTexture::destroy()
+{
+    m_tex_y.destroy();
+    m_tex_u.destroy();
+    m_tex_v.destroy();
+
+    m_width = 0;
+    m_height = 0;
+}
+
+bool GLYUVTexture::update(const unsigned char* data, int width, int height, YUVFormat format)
+{
+    if (data == nullptr)
+    {
+        LOGE("error: data is nullptr");
+        throw std::invalid_argument("error: data is nullptr");
+        return false;
+    }
+
+    //storage is only reallocated when size or layout changes
+    if (!this->isValid() || width != m_width || height != m_height || format != m_format)
+        this->init(width, height, format, m_color_space);
+
+    const int chroma_width = width / 2;
+    const int chroma_height = height / 2;
+
+    const unsigned char* y_plane = data;
+    const unsigned char* c_plane = data + width * height;
+
+    m_tex_y.update(width, height, GL_RED, y_plane);
+
+    if (format == YUVFormat::I420)
+    {
+        m_tex_u.update(chroma_width, chroma_height, GL_RED, c_plane);
+        m_tex_v.update(chroma_width, chroma_height, GL_RED, c_plane + chroma_width * chroma_height);
+    }
+    else
+    {
+        m_tex_u.update(chroma_width, chroma_height, GL_RG, c_plane);
+    }
+
+    m_tex_y.unbind();
+
+    return true;
+}
+
+bool GLYUVTexture::update(const cv::Mat& yuv, YUVFormat format)
+{
+    if (yuv.type() != CV_8UC1 || yuv.rows % 3 != 0)
+    {
+        LOGE("error: yuv image should be CV_8UC1 with (height * 3 / 2) rows");
+        throw std::invalid_argument("error: invalid yuv image");
+        return false;
+    }
+
+    if (!yuv.isContinuous())
+    {
+        LOGE("error: yuv image should be continuous");
+        throw std::invalid_argument("error: yuv image should be continuous");
+        return false;
+    }
+
+    return this->update(yuv.data, yuv.cols, yuv.rows * 2 / 3, format);
+}
+
+void GLYUVTexture::setColorSpace(YUVColorSpace color_space)
+{
+    m_color_space = color_space;
+}
+
+YUVColorSpace GLYUVTexture::getColorSpace() const
+{
+    return m_color_space;
+}
+
+YUVFormat GLYUVTexture::getFormat() const
+{
+    return m_format;
+}
+
+int GLYUVTexture::getWidth() const
+{
+    return m_width;
+}
+
+int GLYUVTexture::getHeight() const
+{
+    return m_height;
+}
+
+bool GLYUVTexture::isValid() const
+{
+    return m_tex_y.isValid();
+}
+
+const GLTexture& GLYUVTexture::getPlane(int index) const
+{
+    if (index == 0)
+        return m_tex_y;
+    if (index == 1)
+        return m_tex_u;
+    if (index == 2 && m_format == YUVFormat::I420)
+        return m_tex_v;
+
+    throw std::out_of_range("error: invalid plane index");
+}
+
+void GLYUVTexture::bind(GLShader& shader) const
+{
+    YUVToRGBCoeffs coeffs = getYUVToRGBCoeffs(m_color_space);
+
+    shader.setTexture("u_tex_y", m_tex_y);
+    shader.setTexture("u_tex_u", m_tex_u);
+
+    if (m_format == YUVFormat::I420)
+        shader.setTexture("u_tex_v", m_tex_v);
+
+    shader.setInt("u_yuv_format", static_cast<int>(m_format));
+    shader.setMat3("u_yuv_matrix", coeffs.matrix);
+    shader.setVec3("u_yuv_offset", coeffs.offset);
+}
+
+bool GLYUVTexture::convert(GLFrameBuffer& dst)
+{
+    if (!this->isValid())
+    {
+        LOGE("error: GLYUVTexture is not initialized");
+        throw std::runtime_error("error: GLYUVTexture is not initialized");
+        return false;
+    }
+
+    if (!m_convert_shader.isValid())
+    {
+        std::string fragment_shader = std::string("precision highp float;\n")
+                                    + YUV_SAMPLING_SHADER
+                                    + YUV_CONVERT_FRAGMENT_SHADER_MAIN;
+
+        m_convert_shader.createFromString(GLFullScreenPass::getVertexShaderSource(), fragment_shader);
+    }
+
+    //every pixel is overwritten, i.e. previous contents need not be loaded
+    GLRenderPass render_pass;
+    render_pass.default_color_action.load_action = GLLoadAction::DONT_CARE;
+    render_pass.depth_action.load_action = GLLoadAction::DONT_CARE;
+
+    dst.beginRenderPass(render_pass);
+
+    m_convert_shader.use();
+    this->bind(m_convert_shader);
+
+    m_fullscreen_pass.draw();
+
+    m_convert_shader.unUse();
+
+    dst.endRenderPass();
+
+    return true;
+}
+
+const char* GLYUVTexture::getSamplingShaderSource()
+{
+    return YUV_SAMPLING_SHADER;
+}
+
+}//end of namespace luna
@@ -0,0 +1,97 @@
+/**
+ * @author     : agent
+ * @date       : 2026-10-18
+ * @description: yuv (I420/NV12/NV21) texture, converted to rgb on GPU
+ * @version    : 1.0
+ */
+
+#pragma once
+
+#include "opencv2/opencv.hpp"
+
+#include "gl_include.h"
+
+#include "gl_texture.h"
+#include "gl_shader.h"
+#include "gl_fullscreen_pass.h"
+#include "gl_yuv_format.h"
+
+namespace luna {
+
+class GLFrameBuffer;
+
+//NOTE: planes are uploaded as-is (Y as R8, UV as RG8 or U/V as R8), i.e. no CPU color conversion.
+//      to sample rgb in your own shader, insert getSamplingShaderSource() into the fragment shader,
+//      call bind(shader) and sampleYUVToRGB(tex_coord) in GLSL.
+//      orientation is the same as GLTexture(cv::Mat) without vertical flip, i.e. row 0 at t = 0.
+
+class GLYUVTexture
+{
+public:
+
+    GLYUVTexture() = default;
+
+    GLYUVTexture(int width, int height, YUVFormat format, YUVColorSpace color_space = YUVColorSpace::BT601_LIMITED);
+
+    bool init(int width, int height, YUVFormat format, YUVColorSpace color_space = YUVColorSpace::BT601_LIMITED);
+
+    ~GLYUVTexture() = default;
+
+    void destroy();
+
+    //disable copy
+    GLYUVTexture(const GLYUVTexture& rhs) = delete;
+    GLYUVTexture& operator = (const GLYUVTexture& rhs) = delete;
+
+    //enable move
+    GLYUVTexture(GLYUVTexture&& rhs) noexcept = default;
+    GLYUVTexture& operator = (GLYUVTexture&& rhs) noexcept = default;
+
+    //-----------
+
+    //data: all planes packed continuously (width * height * 3 / 2 bytes), as produced by decoders & cameras
+    bool update(const unsigned char* data, int width, int height, YUVFormat format);
+
+    //yuv: CV_8UC1, (height * 3 / 2) x width, e.g. cv::COLOR_BGR2YUV_I420 output
+    bool update(const cv::Mat& yuv, YUVFormat format);
+
+    void setColorSpace(YUVColorSpace color_space);
+
+    YUVColorSpace getColorSpace() const;
+
+    YUVFormat getFormat() const;
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    bool isValid() const;
+
+    //plane 0: Y, plane 1: U (I420) or UV/VU (NV12/NV21), plane 2: V (I420 only)
+    const GLTexture& getPlane(int index) const;
+
+    //bind planes & conversion uniforms to a shader which includes getSamplingShaderSource()
+    void bind(GLShader& shader) const;
+
+    //convert to rgba and render into dst (full viewport of dst)
+    bool convert(GLFrameBuffer& dst);
+
+    //GLSL: uniforms + "vec3 sampleYUVToRGB(vec2 tex_coord)"
+    static const char* getSamplingShaderSource();
+
+private:
+    GLTexture m_tex_y;
+    GLTexture m_tex_u;  //U plane for I420, UV plane for NV12/NV21
+    GLTexture m_tex_v;  //V plane for I420
+
+    int m_width = 0;
+    int m_height = 0;
+
+    YUVFormat m_format = YUVFormat::NV21;
+    YUVColorSpace m_color_space = YUVColorSpace::BT601_LIMITED;
+
+    GLShader m_convert_shader;
+    GLFullScreenPass m_fullscreen_pass;
+};
+
+}//end of namespace luna